@@ -0,0 +1,78 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef AUGMENT_H_
+#define AUGMENT_H_
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 서브트리 집계 정책
+ * 기능 : 노드마다 서브트리 전체의 집계값을 유지하기 위한 정책 클래스 모음
+ * 설명 :
+ * - Value : 노드에 저장할 집계값 타입 (void면 집계값을 저장하지 않음)
+ * - FromKey(key) : 노드 하나의 집계값
+ * - Combine(a, b) : 중위 순서로 인접한 두 집계값을 합친 값 (결합 법칙을 만족해야 함)
+ */
+
+// 집계값을 유지하지 않는 기본 정책
+struct NoAugment {
+  using Value = void;
+};
+
+// 서브트리 키 값의 합
+template <typename T, typename Sum = long long> struct SumAugment {
+  using Value = Sum;
+  static Value FromKey(const T &key) { return static_cast<Sum>(key); }
+  static Value Combine(const Value &a, const Value &b) { return a + b; }
+};
+
+// 서브트리 키 값의 최솟값과 최댓값
+template <typename T> struct MinMaxAugment {
+  using Value = std::pair<T, T>;
+  static Value FromKey(const T &key) { return {key, key}; }
+  static Value Combine(const Value &a, const Value &b) {
+    return {std::min(a.first, b.first), std::max(a.second, b.second)};
+  }
+  static const T &Min(const Value &value) { return value.first; }
+  static const T &Max(const Value &value) { return value.second; }
+};
+
+// 집계 정책이 최솟값과 최댓값(Min, Max)을 제공하는지 검사
+template <typename Augment, typename = void>
+struct HasMinMax : std::false_type {};
+template <typename Augment>
+struct HasMinMax<Augment,
+                 std::void_t<decltype(Augment::Min(
+                                 std::declval<typename Augment::Value>())),
+                             decltype(Augment::Max(
+                                 std::declval<typename Augment::Value>()))>>
+    : std::true_type {};
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+
+#ifndef AVL_MAP_H_
+#define AVL_MAP_H_
+
+#include "avl_tree.h"
+#include <utility>
+
+/**
+ * 맵 항목 구조체
+ * 기능 : 키와 값을 한 노드에 저장
+ * 설명 : 값은 트리 순서에 영향을 주지 않으므로 트리 안에서도 수정할 수 있도록 mutable로 선언
+ */
+template <typename K, typename V> struct MapEntry {
+  K first;          // 키
+  mutable V second; // 값
+};
+
+/**
+ * 맵 키 비교 정책
+ * 기능 : 항목의 키만 Compare로 비교하며, 항목 대신 키(또는 Compare가 받는 다른 타입)로도 비교 가능
+ */
+template <typename Compare> struct MapKeyCompare {
+  using is_transparent = void;
+
+  template <typename A, typename B>
+  int operator()(const A &a, const B &b) const {
+    return compare_(KeyOf(a), KeyOf(b));
+  }
+
+private:
+  template <typename K, typename V>
+  static const K &KeyOf(const MapEntry<K, V> &entry) {
+    return entry.first;
+  }
+  template <typename A> static const A &KeyOf(const A &key) { return key; }
+
+  Compare compare_;
+};
+
+/**
+ * AVL 맵 클래스
+ * 기능 : 키마다 값을 가지는 AVL 트리
+ * 설명 :
+ * - AvlTree의 노드와 회전을 그대로 사용하며, 키 순서의 Find, Rank, Select, 반복자를 지원
+ * - 값 갱신은 operator[], try_emplace로 노드를 찾아 제자리에서 수정 (삭제 후 재삽입 없음)
+ * - extract, insert(node_type&&)로 항목을 같은 종류의 다른 맵으로 재할당 없이 옮김
+ */
+template <typename K, typename V,
+          template <typename> class Alloc = NodeAllocator,
+          typename Compare = ThreeWayCompare>
+class AvlMap
+    : public AvlTree<MapEntry<K, V>, Alloc, NoAugment, MapKeyCompare<Compare>> {
+  using Base =
+      AvlTree<MapEntry<K, V>, Alloc, NoAugment, MapKeyCompare<Compare>>;
+
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = MapEntry<K, V>;
+  using NodeType = typename Base::NodeType;
+  using iterator = typename Base::iterator;
+  using node_type = typename Base::node_type;
+
+  using Base::Erase;
+  using Base::Insert;
+
+  /**
+   * 기능 : 키가 없을 때만 값을 만들어 삽입하는 함수
+   * 동작 : 삽입 위치까지 한 번 내려가 같은 키가 있으면 그 항목을 그대로 두고, 없으면 args로 값을 만든 노드를 연결
+   * 입력값 : key - 키 값 (rvalue이면 노드로 옮김), args - V의 생성자 인자
+   * 결과값 : {키의 항목, 삽입 여부}
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+    return EmplaceEntry(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(K &&key, Args &&...args) {
+    return EmplaceEntry(std::move(key), std::forward<Args>(args)...);
+  }
+
+  // key의 값 (없으면 기본값으로 삽입)
+  V &operator[](const K &key) { return try_emplace(key).first->second; }
+  V &operator[](K &&key) { return try_emplace(std::move(key)).first->second; }
+
+  // key의 값, 없으면 nullptr
+  template <typename Key> V *FindValue(const Key &key) const {
+    NodeType *node = this->Find(key).first;
+    return node ? &node->GetKey().second : nullptr;
+  }
+
+  // key의 항목을 삭제 (결과값은 AvlTree::Erase와 같음)
+  int Erase(const K &key) { return this->EraseNode(key); }
+
+private:
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> EmplaceEntry(Key &&key, Args &&...args) {
+    NodeType *node;
+    int sum = 0;
+    bool inserted = this->InsertWith(this->root_, key, node, sum, [&] {
+      return this->allocator_.Allocate(
+          value_type{std::forward<Key>(key), V(std::forward<Args>(args)...)});
+    });
+    return {this->MakeIterator(node), inserted};
+  }
+};
+
+#endif
@@ -28,171 +28,965 @@ Date : 2024-11-26
 #ifndef AVL_TREE_H_
 #define AVL_TREE_H_
 
+#include "node_handle.h"
 #include "set.h"
 #include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+#include <thread>
+#include <vector>
 
 /**
  * AVL 트리 클래스
  * 기능 : AVL 트리 기능 구현
  * 설명 : 이진 탐색 트리의 서브클래스로서, AVL트리에서의 기능을 구현
  */
-template <typename T> class AvlTree : public Set<T> {
+template <typename T, template <typename> class Alloc = NodeAllocator,
+          typename Augment = NoAugment, typename Compare = ThreeWayCompare>
+class AvlTree : public SetCore<T, Alloc, Augment, Compare> {
 public:
-  // 기본 기능 : Insert 함수
-  int Insert(T key) override { return InsertNode(this->GetRoot(), key, 0); }
+  using NodeType = typename SetCore<T, Alloc, Augment, Compare>::NodeType;
+  using iterator = typename SetCore<T, Alloc, Augment, Compare>::iterator;
+  using node_type = NodeHandle<NodeType, Alloc>;
 
-  // 고급 기능 : Erase 함수
-  int Erase(T key) override { return EraseNode(this->GetRoot(), key, 0); }
+  AvlTree() = default;
+  // 정렬되지 않은 범위로부터 트리를 생성
+  template <typename Iterator> AvlTree(Iterator first, Iterator last) {
+    Assign(first, last);
+  }
 
-private:
   /**
-   * 기능 : AVL Tree Node 삽입 함수
-   * 동작 : 적절한 위치에 노드를 삽입하고, 삽입 후 균형 조정 수행
-   * 입력값 : node - 현재 노드의 포인터, key - 삽입할 키 값, depth - 삽입하고자 하는 노드의 깊이 
-   * 결과값 : 삽입된 노드의 깊이와 높이의 합
+   * 기능 : 정렬된 범위로 트리를 다시 구성하는 함수
+   * 동작 : 기존 노드를 모두 해제하고, 중위 순서대로 노드를 만들어 완전 균형 트리를 O(n)에 구성
+   * 입력값 : first, last - 오름차순으로 정렬되고 중복이 없는 키 범위
+   * 결과값 : 없음
    */
-  int InsertNode(Node<T> *&node, T key, int depth) {
-    if (!node) {
-      node = new Node<T>(key);
-      this->size_++;
-      return depth + node->GetHeight(); // 깊이 + 높이 합 반환
+  template <typename Iterator> void AssignSorted(Iterator first, Iterator last) {
+    this->Delete();
+    int count = static_cast<int>(std::distance(first, last));
+    this->allocator_.Reserve(count);
+    this->root_ = BuildTree(first, count, nullptr);
+    this->size_ = count;
+  }
+
+  /**
+   * 기능 : 정렬되지 않은 범위로 트리를 다시 구성하는 함수
+   * 동작 : 키를 복사해 정렬(parallel이면 여러 스레드로 정렬)하고 중복을 제거한 뒤 AssignSorted 수행
+   * 입력값 : first, last - 키 범위, parallel - 병렬 정렬 사용 여부
+   * 결과값 : 없음
+   */
+  template <typename Iterator>
+  void Assign(Iterator first, Iterator last, bool parallel = false) {
+    std::vector<T> keys(first, last);
+    SortKeys(keys, parallel);
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [this](const T &a, const T &b) {
+                             return this->compare_(a, b) == 0;
+                           }),
+               keys.end());
+    AssignSorted(keys.begin(), keys.end());
+  }
+
+  /**
+   * 기능 : 정렬된 키들을 한 번에 삽입하는 함수
+   * 동작 : 키 범위를 노드 키 기준으로 나누어 서브트리마다 한 번만 내려가고, 돌아오며 Join으로 균형 조정
+   * 입력값 : first, last - 오름차순으로 정렬되고 중복이 없는 키 범위 (디버그 빌드에서 assert로 확인,
+   *          정렬되지 않은 키는 Assign처럼 먼저 정렬하고 중복을 제거해야 함)
+   * 결과값 : 키마다 일괄 삽입 후의 깊이와 높이의 합, 이미 존재하던 키는 0
+   */
+  template <typename Iterator>
+  std::vector<int> InsertBatch(Iterator first, Iterator last) {
+    assert(IsStrictlySorted(first, last));
+    std::vector<int> inserted(std::distance(first, last), 1);
+    SetRoot(InsertBatchNode(TakeRoot(), first, last, inserted.data()));
+
+    std::vector<int> results(inserted.size());
+    FindBatchNode(this->root_, first, last, 0, results.data());
+    for (size_t i = 0; i < results.size(); i++)
+      results[i] *= inserted[i];
+    return results;
+  }
+
+  /**
+   * 기능 : 정렬된 키들을 한 번에 삭제하는 함수
+   * 동작 : 키 범위를 노드 키 기준으로 나누어 서브트리마다 한 번만 내려가고, 돌아오며 Join으로 균형 조정
+   * 입력값 : first, last - 오름차순으로 정렬되고 중복이 없는 키 범위 (디버그 빌드에서 assert로 확인)
+   * 결과값 : 키마다 삭제 전의 깊이와 높이의 합, 존재하지 않던 키는 0
+   */
+  template <typename Iterator>
+  std::vector<int> EraseBatch(Iterator first, Iterator last) {
+    assert(IsStrictlySorted(first, last));
+    std::vector<int> results(std::distance(first, last));
+    FindBatchNode(this->root_, first, last, 0, results.data());
+
+    int erased = 0;
+    SetRoot(EraseBatchNode(TakeRoot(), first, last, erased));
+    return results;
+  }
+
+  /**
+   * 기능 : 트리를 key 기준으로 두 트리로 나누는 함수
+   * 동작 : key보다 작은 노드는 left로, 큰 노드는 right로 옮기고 이 트리는 비움
+   * 입력값 : key - 기준 키 값, left, right - 결과를 받을 트리 (기존 노드는 해제됨)
+   * 결과값 : key가 트리에 존재했는지 여부 (존재한 노드는 해제됨)
+   */
+  bool Split(const T &key, AvlTree &left, AvlTree &right) {
+    static_assert(std::is_empty<Alloc<NodeType>>::value,
+                  "트리 사이에서 노드를 옮기려면 상태가 없는 할당자가 필요합니다");
+    NodeType *root = TakeRoot();
+    left.Delete();
+    right.Delete();
+    NodeType *found = SplitNode(root, key, left.root_, right.root_);
+    if (found)
+      this->allocator_.Deallocate(found);
+    left.size_ = RankOf(left.root_);
+    right.size_ = RankOf(right.root_);
+    return found != nullptr;
+  }
+
+  /**
+   * 기능 : 두 트리와 가운데 키를 하나의 트리로 합치는 함수
+   * 동작 : left, key, right를 AVL Join으로 합쳐 이 트리에 저장하고 left, right는 비움
+   * 입력값 : left - 모든 키가 key보다 작은 트리, key - 가운데 키, right - 모든 키가 key보다 큰 트리
+   * 결과값 : 없음
+   */
+  void Join(AvlTree &left, const T &key, AvlTree &right) {
+    static_assert(std::is_empty<Alloc<NodeType>>::value,
+                  "트리 사이에서 노드를 옮기려면 상태가 없는 할당자가 필요합니다");
+    NodeType *left_root = left.TakeRoot();
+    NodeType *right_root = right.TakeRoot();
+    this->Delete();
+    SetRoot(Join(left_root, this->allocator_.Allocate(key), right_root));
+  }
+
+  /**
+   * 기능 : 합집합 함수
+   * 동작 : other의 루트 키로 이 트리를 나누어 양쪽을 재귀적으로(큰 서브트리는 병렬로) 합친 뒤 Join
+   * 입력값 : other - 합칠 트리 (연산 후 비워짐)
+   * 결과값 : 없음
+   */
+  void Union(AvlTree &other) {
+    static_assert(std::is_empty<Alloc<NodeType>>::value,
+                  "트리 사이에서 노드를 옮기려면 상태가 없는 할당자가 필요합니다");
+    if (&other == this)
+      return;
+    NodeType *root = TakeRoot();
+    SetRoot(UnionNode(root, other.TakeRoot(), ForkDepth()));
+  }
+
+  /**
+   * 기능 : 교집합 함수
+   * 동작 : 이 트리의 루트 키로 other를 나누어 양쪽을 재귀적으로(큰 서브트리는 병렬로) 처리한 뒤 Join
+   * 입력값 : other - 교집합을 구할 트리 (연산 후 비워짐)
+   * 결과값 : 없음
+   */
+  void Intersection(AvlTree &other) {
+    static_assert(std::is_empty<Alloc<NodeType>>::value,
+                  "트리 사이에서 노드를 옮기려면 상태가 없는 할당자가 필요합니다");
+    if (&other == this)
+      return;
+    NodeType *root = TakeRoot();
+    SetRoot(IntersectionNode(root, other.TakeRoot(), ForkDepth()));
+  }
+
+  /**
+   * 기능 : 차집합 함수
+   * 동작 : other의 루트 키로 이 트리를 나누어 양쪽을 재귀적으로(큰 서브트리는 병렬로) 처리한 뒤 Join
+   * 입력값 : other - 이 트리에서 제외할 키들의 트리 (연산 후 비워짐)
+   * 결과값 : 없음
+   */
+  void Difference(AvlTree &other) {
+    static_assert(std::is_empty<Alloc<NodeType>>::value,
+                  "트리 사이에서 노드를 옮기려면 상태가 없는 할당자가 필요합니다");
+    if (&other == this) {
+      this->Delete();
+      return;
     }
+    NodeType *root = TakeRoot();
+    SetRoot(DifferenceNode(root, other.TakeRoot(), ForkDepth()));
+  }
 
+  /**
+   * 기능 : 범위 삭제 함수
+   * 동작 : lo와 hi로 트리를 나누어 [lo, hi) 범위의 서브트리를 떼어낸 뒤 해제하고, 나머지를 Join으로 합침
+   * 입력값 : lo - 범위의 시작 키 (포함), hi - 범위의 끝 키 (제외)
+   * 결과값 : 삭제된 노드 개수
+   */
+  int EraseRange(const T &lo, const T &hi) {
+    NodeType *range = DetachRange(lo, hi);
+    int count = RankOf(range);
+    this->DeleteTree(range);
+    return count;
+  }
+
+  /**
+   * 기능 : 범위 추출 함수
+   * 동작 : [lo, hi) 범위의 서브트리를 떼어내 out으로 옮기고, 나머지를 Join으로 합침
+   * 입력값 : lo - 범위의 시작 키 (포함), hi - 범위의 끝 키 (제외), out - 범위를 받을 트리 (기존 노드는 해제됨)
+   * 결과값 : 옮겨진 노드 개수
+   */
+  int ExtractRange(const T &lo, const T &hi, AvlTree &out) {
+    static_assert(std::is_empty<Alloc<NodeType>>::value,
+                  "트리 사이에서 노드를 옮기려면 상태가 없는 할당자가 필요합니다");
+    NodeType *range = DetachRange(lo, hi);
+    out.Delete();
+    out.SetRoot(range);
+    return out.size_;
+  }
+
+  // 기본 기능 : Insert 함수 (rvalue 키는 노드로 옮겨 복사를 생략)
+  int Insert(const T &key) { return InsertFrom(this->root_, key); }
+  int Insert(T &&key) { return InsertFrom(this->root_, std::move(key)); }
+
+  /**
+   * 기능 : 인자로 키를 만들어 삽입하는 함수
+   * 동작 : args로 키를 한 번 생성한 뒤 비교에 사용하고, 새 노드가 필요하면 그 키를 노드로 옮김
+   * 입력값 : args - T의 생성자 인자
+   * 결과값 : Insert(key)와 같음
+   */
+  template <typename... Args> int Emplace(Args &&...args) {
+    return InsertFrom(this->root_, T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * 기능 : 위치 힌트를 사용하는 삽입 함수
+   * 동작 : hint 노드에서 핑거 탐색으로 올라간 뒤 그 서브트리에서만 내려가 삽입 위치를 찾음
+   * 입력값 : hint - 삽입 위치 근처의 반복자 (end()이면 최댓값 노드에서 시작), key - 삽입할 키 값
+   * 결과값 : Insert(key)와 같음
+   * 설명 : 거의 정렬된 키를 end() 힌트로 넣으면 비교는 상수 번으로 줄어듦
+   *        (각 노드가 서브트리 크기를 가지므로 조상의 랭크 갱신은 여전히 높이만큼 필요)
+   */
+  int Insert(iterator hint, const T &key) {
+    return InsertFrom(this->FingerNode(hint.GetNode(), key), key);
+  }
+
+  // 고급 기능 : Erase 함수
+  int Erase(const T &key) { return EraseNode(key); }
+
+  /**
+   * 기능 : 노드 추출 함수
+   * 동작 : key를 가진 노드를 해제하지 않고 트리에서 떼어낸 뒤(Erase와 같은 균형 조정) 핸들로 넘김
+   * 입력값 : key - 추출할 키 값
+   * 결과값 : 노드를 소유한 핸들, key가 없으면 빈 핸들
+   */
+  template <typename K> node_type extract(const K &key) {
     int sum;
-    if (key < node->GetKey()) {
-      // 왼쪽 서브트리에 삽입
-      sum = InsertNode(node->GetLeft(), key, depth + 1);
-      node->GetLeft()->SetParent(node);
-    } else if (key > node->GetKey()) {
-      // 오른쪽 서브트리에 삽입
-      sum = InsertNode(node->GetRight(), key, depth + 1);
-      node->GetRight()->SetParent(node);
+    return node_type(DetachNode(key, sum));
+  }
+
+  /**
+   * 기능 : 노드 핸들 삽입 함수
+   * 동작 : 핸들의 노드를 새로 할당하지 않고 삽입 위치에 그대로 연결
+   * 입력값 : handle - extract로 얻은 핸들
+   * 결과값 : {삽입된 노드 또는 이미 있던 같은 키의 노드, 삽입 여부}
+   *          (같은 키가 이미 있거나 핸들이 비어 있으면 핸들은 그대로 남음)
+   */
+  std::pair<iterator, bool> insert(node_type &&handle) {
+    if (handle.empty())
+      return {this->end(), false};
+    NodeType *node = nullptr;
+    int sum = 0;
+    bool inserted = InsertWith(this->root_, handle.value(), node, sum,
+                               [&handle] { return handle.Release(); });
+    return {this->MakeIterator(node), inserted};
+  }
+
+protected:
+  /**
+   * 기능 : 삽입 위치를 찾아 노드를 연결하는 함수
+   * 동작 : start에서 한 번만 내려가 key와 같은 노드가 없을 때만 make()로 얻은 노드를 연결하고,
+   *        부모 포인터로 올라가며 높이가 변하는 조상까지만 균형 조정 수행
+   * 입력값 : start - 삽입 위치를 찾기 시작할 서브트리의 루트 (key가 그 서브트리 범위 안에 있어야 함),
+   *          key - 삽입할 키 값, node - 연결된 노드 또는 이미 있던 같은 키의 노드를 받을 변수,
+   *          sum - 노드의 깊이와 높이의 합을 받을 변수 (같은 키의 노드가 루트이면 0),
+   *          make - 연결할 노드를 반환하는 함수 (부모, 자식이 없는 노드)
+   * 결과값 : 새 노드를 연결했으면 true, 이미 존재하는 키인 경우 false
+   */
+  template <typename K, typename Make>
+  bool InsertWith(NodeType *start, const K &key, NodeType *&node, int &sum,
+                  Make make) {
+    // 1. 삽입 위치까지 한 번만 하강 (노드마다 비교는 한 번)
+    NodeType *parent = nullptr;
+    int order = 0;
+    for (node = start; node;) {
+      parent = node;
+      order = this->compare_(key, node->GetKey());
+      if (order < 0) {
+        node = node->GetLeft();
+      } else if (order > 0) {
+        node = node->GetRight();
+      } else {
+        // 이미 있는 노드의 깊이는 부모 포인터로 루트까지 올라가며 계산
+        sum = 0;
+        if (node != this->root_) {
+          for (NodeType *n = node; n != this->root_; n = n->GetParent())
+            sum++;
+          sum += node->GetHeight();
+        }
+        return false;
+      }
+    }
+
+    // 2. 새 노드를 부모에 연결
+    NodeType *new_node = make();
+    node = new_node;
+    this->size_++;
+    if (!parent) {
+      this->root_ = new_node;
+      this->max_node_ = new_node;
+      sum = new_node->GetHeight();
+      return true;
+    }
+    new_node->SetParent(parent);
+    if (order < 0) {
+      parent->SetLeft(new_node);
     } else {
-      return 0;
+      parent->SetRight(new_node);
+      // 최댓값 노드의 오른쪽에 붙으면 새 최댓값 (회전은 노드를 옮기지 않으므로 캐시가 유지됨)
+      if (parent == this->max_node_)
+        this->max_node_ = new_node;
+    }
+
+    // 3. 루트까지 올라가며 랭크 갱신, 높이가 변하는 동안만 균형 조정
+    int new_depth = 0;
+    bool retracing = true;
+    for (NodeType *cur = parent; cur; cur = cur->GetParent()) {
+      new_depth++;
+      cur->SetRank(cur->GetRank() + 1);
+      NodeAggregateUpdate(cur);
+      if (!retracing)
+        continue;
+
+      int old_height = cur->GetHeight();
+      NodeHeightUpdate(cur);
+      int balance = GetBalanceFactor(cur);
+      if (balance > 1 || balance < -1) {
+        // 삽입 시 회전은 최대 한 번이며, 회전 후 서브트리 높이는 삽입 전과 같음
+        cur = ReBalanceTree(cur);
+        new_depth = 0;
+        for (NodeType *n = new_node; n != cur; n = n->GetParent())
+          new_depth++;
+        retracing = false;
+      } else if (cur->GetHeight() == old_height) {
+        retracing = false;
+      }
     }
 
-    // 균형 조정
-    node = ReBalanceTree(node);
+    sum = new_depth + new_node->GetHeight();
+    return true;
+  }
+
+  /**
+   * 기능 : AVL Tree Node 삭제 함수
+   * 동작 : DetachNode로 떼어낸 노드를 해제
+   * 입력값 : key - 삭제할 키 값
+   * 결과값 : 삭제된 노드의 깊이와 높이의 합, 노드가 없는 경우 0
+   */
+  template <typename K> int EraseNode(const K &key) {
+    int sum = 0;
+    if (NodeType *node = DetachNode(key, sum))
+      this->allocator_.Deallocate(node);
+    return sum;
+  }
+
+private:
+  // 경로 스택의 최대 길이 (노드 수가 int 범위일 때 AVL 트리의 높이는 45 이하)
+  static constexpr int kMaxHeight = 64;
+  // 병렬 정렬을 사용하는 최소 키 개수
+  static constexpr size_t kParallelSortThreshold = 1 << 16;
+  // 집합 연산에서 새 스레드로 나누는 최소 노드 개수
+  static constexpr int kForkThreshold = 1 << 14;
+
+  /**
+   * 기능 : 정렬된 범위로 완전 균형 서브트리를 만드는 함수
+   * 동작 : 왼쪽 서브트리, 가운데 노드, 오른쪽 서브트리 순서로 반복자를 한 번만 전진시키며 생성
+   * 입력값 : it - 다음에 사용할 키의 반복자, count - 서브트리의 노드 개수, parent - 부모 노드
+   * 결과값 : 생성된 서브트리의 루트 노드
+   */
+  template <typename Iterator>
+  NodeType *BuildTree(Iterator &it, int count, NodeType *parent) {
+    if (count == 0)
+      return nullptr;
+
+    int left_count = count / 2;
+    NodeType *left = BuildTree(it, left_count, nullptr);
+    NodeType *node = this->allocator_.Allocate(*it);
+    ++it;
+    NodeType *right = BuildTree(it, count - left_count - 1, node);
 
-    // 조정 후 높이 및 랭크 업데이트
+    node->SetParent(parent);
+    node->SetLeft(left);
+    node->SetRight(right);
+    // 왼쪽 서브트리는 가운데 노드보다 먼저 만들어지므로 부모를 나중에 연결
+    if (left)
+      left->SetParent(node);
     NodeHeightUpdate(node);
     NodeRankUpdate(node);
+    return node;
+  }
+
+  /**
+   * 기능 : 서브트리에 정렬된 키들을 삽입하는 함수
+   * 동작 : 노드 키를 기준으로 키 범위를 나누어 양쪽 서브트리에 재귀적으로 삽입한 뒤 Join으로 다시 연결
+   * 입력값 : node - 분리된 서브트리의 루트, first, last - 삽입할 키 범위, inserted - 키마다 삽입 여부를 기록할 위치
+   * 결과값 : 삽입 후 서브트리의 새로운 루트 노드
+   */
+  template <typename Iterator>
+  NodeType *InsertBatchNode(NodeType *node, Iterator first, Iterator last,
+                           int *inserted) {
+    if (first == last)
+      return node;
+    if (!node)
+      return BuildTree(first, static_cast<int>(std::distance(first, last)),
+                       nullptr);
 
-    // 최종적으로 삽입된 노드의 깊이 + 높이를 다시 측정
-    auto findNode = this->Find(key);
-    if (findNode.first) {
-      sum = findNode.second;
+    Iterator mid = std::lower_bound(first, last, node->GetKey(), KeyLess());
+    Iterator next = mid;
+    if (mid != last && this->compare_(node->GetKey(), *mid) == 0) {
+      // 이미 존재하는 키
+      inserted[std::distance(first, mid)] = 0;
+      ++next;
     }
 
-    return sum;
+    NodeType *left = DetachChild(node->GetLeft());
+    NodeType *right = DetachChild(node->GetRight());
+    left = InsertBatchNode(left, first, mid, inserted);
+    right = InsertBatchNode(right, next, last,
+                            inserted + std::distance(first, next));
+    return Join(left, node, right);
   }
 
   /**
-   * 기능 : AVL Tree Node 삭제 함수
-   * 동작 : 트리에서 특정 키 값을 가진 노드를 삭제하고 트리를 균형 상태로 유지
-   * 입력값 : node - 현재 노드의 포인터, key - 삭제할 키 값, depth - 삭제하고자하는 노드의 깊이 
-   * 결과값 : 삭제된 노드의 깊이와 높이의 합
+   * 기능 : 서브트리에서 정렬된 키들을 삭제하는 함수
+   * 동작 : 노드 키를 기준으로 키 범위를 나누어 양쪽 서브트리에서 재귀적으로 삭제한 뒤 다시 연결
+   * 입력값 : node - 분리된 서브트리의 루트, first, last - 삭제할 키 범위, erased - 삭제된 노드 개수
+   * 결과값 : 삭제 후 서브트리의 새로운 루트 노드
    */
-  int EraseNode(Node<T> *&node, T key, int depth) {
-    if (node == nullptr) {
-      // 노드가 없으면 0 반환
-      return 0;
+  template <typename Iterator>
+  NodeType *EraseBatchNode(NodeType *node, Iterator first, Iterator last,
+                          int &erased) {
+    if (first == last || !node)
+      return node;
+
+    Iterator mid = std::lower_bound(first, last, node->GetKey(), KeyLess());
+    Iterator next = mid;
+    bool found = mid != last && this->compare_(node->GetKey(), *mid) == 0;
+    if (found)
+      ++next;
+
+    NodeType *left = DetachChild(node->GetLeft());
+    NodeType *right = DetachChild(node->GetRight());
+    left = EraseBatchNode(left, first, mid, erased);
+    right = EraseBatchNode(right, next, last, erased);
+    if (!found)
+      return Join(left, node, right);
+
+    this->allocator_.Deallocate(node);
+    erased++;
+    return Join2(left, right);
+  }
+
+  /**
+   * 기능 : 서브트리를 key 기준으로 나누는 함수
+   * 동작 : key를 찾아 내려가며 경로 밖의 서브트리들을 Join으로 왼쪽, 오른쪽 트리에 모음
+   * 입력값 : node - 분리된 서브트리의 루트, key - 기준 키 값, left, right - 결과 서브트리의 루트
+   * 결과값 : key를 가진 노드 (분리된 상태), 없으면 nullptr
+   */
+  NodeType *SplitNode(NodeType *node, const T &key, NodeType *&left,
+                     NodeType *&right) {
+    if (!node) {
+      left = right = nullptr;
+      return nullptr;
     }
 
-    int sum = 0;
+    NodeType *node_left = DetachChild(node->GetLeft());
+    NodeType *node_right = DetachChild(node->GetRight());
+    int order = this->compare_(key, node->GetKey());
+    if (order < 0) {
+      NodeType *found = SplitNode(node_left, key, left, right);
+      right = Join(right, node, node_right);
+      return found;
+    }
+    if (order > 0) {
+      NodeType *found = SplitNode(node_right, key, left, right);
+      left = Join(node_left, node, left);
+      return found;
+    }
 
-    if (key < node->GetKey()) {
-      sum = EraseNode(node->GetLeft(), key, depth + 1);
-      // sum이 0 이상이면 삭제가 이루어졌다는 뜻
-      if (sum > 0) {
-        // 부모 설정
-        if (node->GetLeft())
-          node->GetLeft()->SetParent(node);
-        // 균형 조정
-        node = ReBalanceTree(node);
-
-        // 조정 후 높이 및 랭크 업데이트
-        NodeHeightUpdate(node);
-        NodeRankUpdate(node);
-      }
-    } else if (key > node->GetKey()) {
-      sum = EraseNode(node->GetRight(), key, depth + 1);
-      if (sum > 0) {
-        // 부모 설정
-        if (node->GetRight())
-          node->GetRight()->SetParent(node);
-        // 균형 조정
-        node = ReBalanceTree(node);
-
-        // 조정 후 높이 및 랭크 업데이트
-        NodeHeightUpdate(node);
-        NodeRankUpdate(node);
-      }
+    left = node_left;
+    right = node_right;
+    node->SetLeft(nullptr);
+    node->SetRight(nullptr);
+    return node;
+  }
+
+  /**
+   * 기능 : 트리에서 [lo, hi) 범위를 떼어내는 함수
+   * 동작 : lo로 나눈 오른쪽을 다시 hi로 나누어 가운데를 떼어내고, 양쪽 나머지를 Join하여 루트로 설정
+   * 입력값 : lo - 범위의 시작 키 (포함), hi - 범위의 끝 키 (제외)
+   * 결과값 : 떼어낸 범위 서브트리의 루트 (부모 없음)
+   */
+  NodeType *DetachRange(const T &lo, const T &hi) {
+    if (!this->Less(lo, hi))
+      return nullptr;
+
+    NodeType *left, *rest, *range, *right;
+    NodeType *lo_node = SplitNode(TakeRoot(), lo, left, rest);
+    NodeType *hi_node = SplitNode(rest, hi, range, right);
+    // lo는 범위에 포함되고 hi는 포함되지 않음
+    if (lo_node)
+      range = Join(nullptr, lo_node, range);
+    SetRoot(hi_node ? Join(left, hi_node, right) : Join2(left, right));
+    return range;
+  }
+
+  // 두 서브트리의 합집합 (other의 키가 중복되면 other의 노드를 해제)
+  NodeType *UnionNode(NodeType *node, NodeType *other, int fork_depth) {
+    if (!node)
+      return other;
+    if (!other)
+      return node;
+
+    bool fork = ShouldFork(fork_depth, node, other);
+    NodeType *node_left = DetachChild(node->GetLeft());
+    NodeType *node_right = DetachChild(node->GetRight());
+    NodeType *other_left, *other_right;
+    NodeType *found = SplitNode(other, node->GetKey(), other_left, other_right);
+    if (found)
+      this->allocator_.Deallocate(found);
+
+    NodeType *left, *right;
+    ForkJoin(
+        fork,
+        [&] { left = UnionNode(node_left, other_left, fork_depth - 1); },
+        [&] { right = UnionNode(node_right, other_right, fork_depth - 1); });
+    return Join(left, node, right);
+  }
+
+  // 두 서브트리의 교집합 (한쪽에만 있는 노드는 해제)
+  NodeType *IntersectionNode(NodeType *node, NodeType *other, int fork_depth) {
+    if (!node || !other) {
+      this->DeleteTree(node);
+      this->DeleteTree(other);
+      return nullptr;
     }
-    // 삭제해야 할 노드일 경우
-    // 2. 자식 노드 수에 따라 삭제
-    else {
-      // 삭제해야하는 노드의 깊이와 높이의 합 계산
-      sum = depth + node->GetHeight();
-
-      // 자식 노드가 하나 이하인 경우
-      if (!node->GetLeft() || !node->GetRight()) {
-        Node<T> *replace_node =
-            node->GetLeft() ? node->GetLeft() : node->GetRight();
-        // 2.1 자식이 없는 경우 (리프 노드)
-        if (!replace_node) {
-          delete node;
-          node = nullptr;
-        }
-        // 2.2 자식이 하나인 경우
-        else {
-          Node<T> *cur_node = node;
-          node = replace_node;
-          // 부모 설정
-          node->SetParent(cur_node->GetParent());
-          delete cur_node;
-        }
-        // 노드 삭제 시 크기 감소
-        this->size_--;
-      } else {
-        // 2.3 자식이 둘인 경우 후임자(successor)를 찾아 대체
-        Node<T> *replace_node = Set<T>::FindMinNode(node->GetRight());
-        node->SetKey(replace_node->GetKey());
-        // 후임자 노드를 삭제
-        // 이때 반환되는 깊이와 높이의 합은 삭제 연산과 직접적인 관련이 없으므로
-        // 무시 가능
-        int dummy_sum =
-            EraseNode(node->GetRight(), replace_node->GetKey(), depth + 1);
-        if (node->GetRight())
-          node->GetRight()->SetParent(node);
-        // 균형 조정
-        node = ReBalanceTree(node);
-
-        // 조정 후 높이 및 랭크 업데이트
-        NodeHeightUpdate(node);
-        NodeRankUpdate(node);
-      }
+
+    bool fork = ShouldFork(fork_depth, node, other);
+    NodeType *node_left = DetachChild(node->GetLeft());
+    NodeType *node_right = DetachChild(node->GetRight());
+    NodeType *other_left, *other_right;
+    NodeType *found = SplitNode(other, node->GetKey(), other_left, other_right);
+
+    NodeType *left, *right;
+    ForkJoin(
+        fork,
+        [&] { left = IntersectionNode(node_left, other_left, fork_depth - 1); },
+        [&] {
+          right = IntersectionNode(node_right, other_right, fork_depth - 1);
+        });
+    if (found) {
+      this->allocator_.Deallocate(found);
+      return Join(left, node, right);
     }
+    this->allocator_.Deallocate(node);
+    return Join2(left, right);
+  }
 
-    if (node != nullptr) {
-      // 균형 조정
-      node = ReBalanceTree(node);
+  // 두 서브트리의 차집합 (other의 노드와 일치하는 노드는 모두 해제)
+  NodeType *DifferenceNode(NodeType *node, NodeType *other, int fork_depth) {
+    if (!node || !other) {
+      this->DeleteTree(other);
+      return node;
+    }
+
+    bool fork = ShouldFork(fork_depth, node, other);
+    NodeType *other_left = DetachChild(other->GetLeft());
+    NodeType *other_right = DetachChild(other->GetRight());
+    NodeType *node_left, *node_right;
+    NodeType *found = SplitNode(node, other->GetKey(), node_left, node_right);
+    this->allocator_.Deallocate(other);
+    if (found)
+      this->allocator_.Deallocate(found);
+
+    NodeType *left, *right;
+    ForkJoin(
+        fork,
+        [&] { left = DifferenceNode(node_left, other_left, fork_depth - 1); },
+        [&] {
+          right = DifferenceNode(node_right, other_right, fork_depth - 1);
+        });
+    return Join2(left, right);
+  }
+
+  // 병렬로 나눌 수 있는 재귀 깊이 (코어 수의 log2 + 1)
+  static int ForkDepth() {
+    int depth = 1;
+    for (unsigned int cores = std::thread::hardware_concurrency(); cores > 1;
+         cores >>= 1)
+      depth++;
+    return depth;
+  }
+
+  // 남은 병렬 깊이가 있고 두 서브트리가 충분히 클 때만 병렬로 처리
+  static bool ShouldFork(int fork_depth, NodeType *node, NodeType *other) {
+    return fork_depth > 0 && RankOf(node) + RankOf(other) >= kForkThreshold;
+  }
+
+  // fork가 참이면 first를 새 스레드에서, second를 현재 스레드에서 실행한 뒤 기다림
+  template <typename First, typename Second>
+  static void ForkJoin(bool fork, First &&first, Second &&second) {
+    if (!fork) {
+      first();
+      second();
+      return;
+    }
+    std::thread worker(std::forward<First>(first));
+    second();
+    worker.join();
+  }
 
-      // 조정 후 높이 및 랭크 업데이트
+  // 루트를 떼어내고 트리를 비움 (일괄 연산 중에는 root_가 어떤 노드도 가리키지 않음)
+  NodeType *TakeRoot() {
+    NodeType *root = this->root_;
+    this->root_ = nullptr;
+    this->size_ = 0;
+    this->max_node_ = nullptr;
+    return root;
+  }
+
+  // 부모가 없는 서브트리를 트리의 루트로 설정
+  void SetRoot(NodeType *root) {
+    this->root_ = root;
+    this->size_ = RankOf(root);
+    this->max_node_ = nullptr;
+  }
+
+  static int RankOf(NodeType *node) { return node ? node->GetRank() : 0; }
+
+  /**
+   * 기능 : 여러 키의 깊이와 높이의 합을 한 번에 계산하는 함수
+   * 동작 : 노드 키를 기준으로 정렬된 키 범위를 나누어 서브트리마다 한 번만 내려감
+   * 입력값 : node - 현재 노드, first, last - 찾을 키 범위, depth - 현재 깊이, out - 결과를 기록할 위치
+   * 결과값 : 없음 (키마다 깊이 + 높이, 없으면 0을 out에 기록)
+   */
+  template <typename Iterator>
+  void FindBatchNode(NodeType *node, Iterator first, Iterator last, int depth,
+                     int *out) const {
+    if (first == last)
+      return;
+    if (!node) {
+      std::fill(out, out + std::distance(first, last), 0);
+      return;
+    }
+
+    Iterator mid = std::lower_bound(first, last, node->GetKey(), KeyLess());
+    FindBatchNode(node->GetLeft(), first, mid, depth + 1, out);
+    out += std::distance(first, mid);
+    if (mid != last && this->compare_(node->GetKey(), *mid) == 0) {
+      *out++ = depth + node->GetHeight();
+      ++mid;
+    }
+    FindBatchNode(node->GetRight(), mid, last, depth + 1, out);
+  }
+
+  /**
+   * 기능 : 두 서브트리와 가운데 노드를 하나의 AVL 트리로 합치는 함수
+   * 동작 : 높이 차가 1 이하면 바로 연결하고, 아니면 높은 쪽의 경계를 따라 내려가 연결한 뒤 균형 조정
+   * 입력값 : left, right - 부모가 없는 서브트리 (left의 키 < key_node의 키 < right의 키), key_node - 가운데 노드
+   * 결과값 : 합쳐진 트리의 루트 노드 (부모 없음)
+   */
+  NodeType *Join(NodeType *left, NodeType *key_node, NodeType *right) {
+    if (HeightOf(left) > HeightOf(right) + 1)
+      return JoinRight(left, key_node, right);
+    if (HeightOf(right) > HeightOf(left) + 1)
+      return JoinLeft(left, key_node, right);
+    LinkChildren(key_node, left, right);
+    key_node->SetParent(nullptr);
+    return key_node;
+  }
+
+  // left가 더 높은 경우, left의 오른쪽 경계에 key_node와 right를 연결
+  NodeType *JoinRight(NodeType *left, NodeType *key_node, NodeType *right) {
+    NodeType *parent = nullptr;
+    NodeType *cur = left;
+    while (HeightOf(cur) > HeightOf(right) + 1) {
+      parent = cur;
+      cur = cur->GetRight();
+    }
+    LinkChildren(key_node, cur, right);
+    parent->SetRight(key_node);
+    key_node->SetParent(parent);
+    return RetraceSpine(parent);
+  }
+
+  // right가 더 높은 경우, right의 왼쪽 경계에 left와 key_node를 연결
+  NodeType *JoinLeft(NodeType *left, NodeType *key_node, NodeType *right) {
+    NodeType *parent = nullptr;
+    NodeType *cur = right;
+    while (HeightOf(cur) > HeightOf(left) + 1) {
+      parent = cur;
+      cur = cur->GetLeft();
+    }
+    LinkChildren(key_node, left, cur);
+    parent->SetLeft(key_node);
+    key_node->SetParent(parent);
+    return RetraceSpine(parent);
+  }
+
+  /**
+   * 기능 : 가운데 노드 없이 두 서브트리를 합치는 함수
+   * 동작 : right의 최솟값 노드를 떼어내 가운데 노드로 사용하여 Join 수행
+   * 입력값 : left, right - 부모가 없는 서브트리 (left의 키 < right의 키)
+   * 결과값 : 합쳐진 트리의 루트 노드 (부모 없음)
+   */
+  NodeType *Join2(NodeType *left, NodeType *right) {
+    if (!right)
+      return left;
+    NodeType *min_node = nullptr;
+    right = SplitMin(right, min_node);
+    return Join(left, min_node, right);
+  }
+
+  // 서브트리에서 최솟값 노드를 떼어내고, 남은 서브트리의 루트를 반환
+  NodeType *SplitMin(NodeType *node, NodeType *&min_node) {
+    NodeType *right = DetachChild(node->GetRight());
+    if (!node->GetLeft()) {
+      min_node = node;
+      return right;
+    }
+    NodeType *left = SplitMin(DetachChild(node->GetLeft()), min_node);
+    return Join(left, node, right);
+  }
+
+  // 경계 노드부터 부모가 없는 노드까지 높이와 랭크를 갱신하며 균형 조정
+  NodeType *RetraceSpine(NodeType *node) {
+    NodeType *top = node;
+    for (; node; node = node->GetParent()) {
       NodeHeightUpdate(node);
       NodeRankUpdate(node);
+      node = ReBalanceTree(node);
+      top = node;
     }
+    return top;
+  }
+
+  // 노드에 두 자식을 연결하고 높이와 랭크를 갱신
+  void LinkChildren(NodeType *node, NodeType *left, NodeType *right) {
+    node->SetLeft(left);
+    node->SetRight(right);
+    if (left)
+      left->SetParent(node);
+    if (right)
+      right->SetParent(node);
+    NodeHeightUpdate(node);
+    NodeRankUpdate(node);
+  }
+
+  // 자식 서브트리를 부모에서 분리 (부모의 자식 포인터는 호출한 쪽에서 다시 연결)
+  NodeType *DetachChild(NodeType *child) {
+    if (child)
+      child->SetParent(nullptr);
+    return child;
+  }
+
+  int HeightOf(NodeType *node) const { return node ? node->GetHeight() : 0; }
+
+  // 비교 정책을 std::sort, std::lower_bound 등에 넘길 때 쓰는 < 함수 객체
+  auto KeyLess() const {
+    return [this](const T &a, const T &b) { return this->Less(a, b); };
+  }
+
+  // 키 범위가 오름차순으로 정렬되고 중복이 없는지 여부 (일괄 연산의 입력 확인용)
+  template <typename Iterator>
+  bool IsStrictlySorted(Iterator first, Iterator last) const {
+    return std::adjacent_find(first, last, [this](const T &a, const T &b) {
+             return !this->Less(a, b);
+           }) == last;
+  }
+
+  /**
+   * 기능 : 키 정렬 함수
+   * 동작 : 구간별로 스레드를 나누어 정렬한 뒤, 인접한 구간을 병합하는 과정을 반복
+   *        (하드웨어 스레드가 하나여도 구간을 둘 이상으로 나누어 같은 병합 경로를 사용)
+   * 입력값 : keys - 정렬할 키 배열, parallel - 병렬 정렬 사용 여부
+   * 결과값 : 없음
+   */
+  void SortKeys(std::vector<T> &keys, bool parallel) const {
+    auto less = KeyLess();
+    size_t chunks = std::max(2u, std::thread::hardware_concurrency());
+    if (!parallel || keys.size() < kParallelSortThreshold) {
+      std::sort(keys.begin(), keys.end(), less);
+      return;
+    }
+
+    // 각 구간의 경계
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t i = 0; i <= chunks; i++)
+      bounds[i] = keys.size() * i / chunks;
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < chunks; i++)
+      workers.emplace_back([&keys, &bounds, less, i] {
+        std::sort(keys.begin() + bounds[i], keys.begin() + bounds[i + 1],
+                  less);
+      });
+    for (std::thread &worker : workers)
+      worker.join();
+
+    // 크기가 width인 인접 구간끼리 병합
+    for (size_t width = 1; width < chunks; width *= 2) {
+      workers.clear();
+      for (size_t i = 0; i + width < chunks; i += 2 * width) {
+        size_t mid = bounds[i + width];
+        size_t end = bounds[std::min(i + 2 * width, chunks)];
+        size_t begin = bounds[i];
+        workers.emplace_back([&keys, less, begin, mid, end] {
+          std::inplace_merge(keys.begin() + begin, keys.begin() + mid,
+                             keys.begin() + end, less);
+        });
+      }
+      for (std::thread &worker : workers)
+        worker.join();
+    }
+  }
 
+  /**
+   * 기능 : AVL Tree Node 삽입 함수
+   * 동작 : InsertWith로 삽입 위치를 찾고, 같은 키가 없을 때만 노드를 할당
+   * 입력값 : start - 삽입 위치를 찾기 시작할 서브트리의 루트, key - 삽입할 키 값 (rvalue이면 노드로 옮김)
+   * 결과값 : 삽입된 노드 또는 이미 있던 같은 키의 노드의 깊이와 높이의 합 (그 노드가 루트이면 0)
+   */
+  template <typename Key> int InsertFrom(NodeType *start, Key &&key) {
+    NodeType *node;
+    int sum = 0;
+    InsertWith(start, key, node, sum, [this, &key] {
+      return this->allocator_.Allocate(std::forward<Key>(key));
+    });
     return sum;
   }
 
+  /**
+   * 기능 : 노드 분리 함수
+   * 동작 : 삭제할 노드를 떼어내고 자식이 둘이면 후임자 노드를 그 자리로 옮긴 뒤, 높이가 변하는 조상까지만 균형 조정
+   * 입력값 : key - 떼어낼 키 값, sum - 떼어내기 전 노드의 깊이와 높이의 합을 받을 변수 (없으면 0)
+   * 결과값 : 부모, 자식이 없는 단일 노드 상태로 만든 노드, 노드가 없는 경우 nullptr
+   */
+  template <typename K> NodeType *DetachNode(const K &key, int &sum) {
+    NodeType *path[kMaxHeight]; // 루트부터 구조가 바뀌는 지점까지의 경로
+    int depth = 0;
+
+    // 1. 삭제할 노드까지 한 번만 하강
+    NodeType *node = this->root_;
+    while (node) {
+      int order = this->compare_(key, node->GetKey());
+      if (order < 0) {
+        path[depth++] = node;
+        node = node->GetLeft();
+      } else if (order > 0) {
+        path[depth++] = node;
+        node = node->GetRight();
+      } else {
+        break;
+      }
+    }
+    sum = 0;
+    if (!node)
+      return nullptr;
+
+    // 삭제해야하는 노드의 깊이와 높이의 합 계산
+    sum = depth + node->GetHeight();
+
+    if (!node->GetLeft() || !node->GetRight()) {
+      // 최댓값 노드는 오른쪽 자식이 없으므로 항상 여기서 떼어지며,
+      // 다음 최댓값은 왼쪽 자식(AVL 균형으로 단일 노드) 또는 부모
+      if (node == this->max_node_)
+        this->max_node_ = node->GetLeft() ? node->GetLeft() : node->GetParent();
+      // 2.1 자식이 하나 이하인 경우, 자식이 삭제할 노드의 자리를 대신함
+      ReplaceChild(node, node->GetLeft() ? node->GetLeft() : node->GetRight());
+    } else {
+      // 2.2 자식이 둘인 경우, 후임자 노드를 떼어내 삭제할 노드의 자리로 옮김
+      int node_index = depth;
+      path[depth++] = node;
+      NodeType *successor = node->GetRight();
+      while (successor->GetLeft()) {
+        path[depth++] = successor;
+        successor = successor->GetLeft();
+      }
+
+      if (successor != node->GetRight()) {
+        // 후임자의 오른쪽 자식을 후임자의 원래 자리에 연결
+        NodeType *successor_parent = successor->GetParent();
+        successor_parent->SetLeft(successor->GetRight());
+        if (successor->GetRight())
+          successor->GetRight()->SetParent(successor_parent);
+        successor->SetRight(node->GetRight());
+        node->GetRight()->SetParent(successor);
+      }
+      successor->SetLeft(node->GetLeft());
+      node->GetLeft()->SetParent(successor);
+      successor->SetHeight(node->GetHeight());
+      successor->SetRank(node->GetRank());
+      ReplaceChild(node, successor);
+      path[node_index] = successor;
+    }
+    // 노드 삭제 시 크기 감소
+    this->size_--;
+
+    // 3. 경로를 거슬러 올라가며 랭크 갱신, 높이가 변하는 동안만 균형 조정
+    bool retracing = true;
+    for (int i = depth - 1; i >= 0; i--) {
+      NodeType *cur = path[i];
+      cur->SetRank(cur->GetRank() - 1);
+      NodeAggregateUpdate(cur);
+      if (!retracing)
+        continue;
+
+      int old_height = cur->GetHeight();
+      NodeHeightUpdate(cur);
+      int balance = GetBalanceFactor(cur);
+      if (balance > 1 || balance < -1)
+        cur = ReBalanceTree(cur);
+      // 삭제 시에는 회전 후에도 높이가 줄어들 수 있으므로 높이가 같아질 때까지 진행
+      if (cur->GetHeight() == old_height)
+        retracing = false;
+    }
+
+    // 떼어낸 노드를 단일 노드 상태로 초기화
+    node->SetParent(nullptr);
+    node->SetLeft(nullptr);
+    node->SetRight(nullptr);
+    node->SetHeight(1);
+    NodeRankUpdate(node);
+    return node;
+  }
+
+  /**
+   * 기능 : 부모가 가리키는 자식 노드를 교체하는 함수
+   * 동작 : old_node의 부모(없으면 루트)가 new_node를 가리키도록 하고, new_node의 부모를 설정
+   * 입력값 : old_node - 교체될 노드, new_node - 새로 연결할 노드 (nullptr 가능)
+   * 결과값 : 없음
+   */
+  void ReplaceChild(NodeType *old_node, NodeType *new_node) {
+    NodeType *parent = old_node->GetParent();
+    if (new_node)
+      new_node->SetParent(parent);
+
+    if (!parent)
+      this->root_ = new_node;
+    else if (parent->GetLeft() == old_node)
+      parent->SetLeft(new_node);
+    else
+      parent->SetRight(new_node);
+  }
+
   /**
    * 기능 : 트리의 균형을 맞추기 위한 함수
    * 동작 : 균형 인수를 계산 후, 조건에 따른 회전 수행
    * 입력값 : node - 균형 조정을 수행할 노드
    * 결과값 : 균형 조정된 서브트리의 새로운 루트 노드
    */
-  Node<T> *ReBalanceTree(Node<T> *node) {
+  NodeType *ReBalanceTree(NodeType *node) {
     // 균형 인수 계산
     int balance = GetBalanceFactor(node);
 
@@ -227,7 +1021,7 @@ private:
    * 입력값 : node - 높이를 갱신할 노드
    * 결과값 : 없음
    */
-  void NodeHeightUpdate(Node<T> *node) {
+  void NodeHeightUpdate(NodeType *node) {
     if (!node)
       return;
     int left_height = node->GetLeft() ? node->GetLeft()->GetHeight() : 0;
@@ -237,16 +1031,35 @@ private:
 
   /**
    * 기능 : 노드의 랭크를 갱신하는 함수
-   * 동작 : 노드의 왼쪽과 오른쪽 자식의 랭크를 기반으로 현재 노드의 랭크를 갱신
+   * 동작 : 노드의 왼쪽과 오른쪽 자식의 랭크를 기반으로 현재 노드의 랭크(와 집계값)를 갱신
    * 입력값 : node - 랭크를 갱신할 노드
    * 결과값 : 없음
    */
-  void NodeRankUpdate(Node<T> *node) {
+  void NodeRankUpdate(NodeType *node) {
     if (!node)
       return;
     int left_rank = node->GetLeft() ? node->GetLeft()->GetRank() : 0;
     int right_rank = node->GetRight() ? node->GetRight()->GetRank() : 0;
     node->SetRank(1 + left_rank + right_rank);
+    NodeAggregateUpdate(node);
+  }
+
+  /**
+   * 기능 : 노드의 서브트리 집계값을 갱신하는 함수
+   * 동작 : 왼쪽 자식 집계값, 노드 키, 오른쪽 자식 집계값을 중위 순서대로 Combine (집계 정책이 없으면 무시)
+   * 입력값 : node - 집계값을 갱신할 노드
+   * 결과값 : 없음
+   */
+  void NodeAggregateUpdate(NodeType *node) {
+    if constexpr (!std::is_void<typename Augment::Value>::value) {
+      typename Augment::Value aggregate = Augment::FromKey(node->GetKey());
+      if (node->GetLeft())
+        aggregate = Augment::Combine(node->GetLeft()->GetAggregate(), aggregate);
+      if (node->GetRight())
+        aggregate =
+            Augment::Combine(aggregate, node->GetRight()->GetAggregate());
+      node->SetAggregate(aggregate);
+    }
   }
 
   /**
@@ -255,7 +1068,7 @@ private:
    * 입력값 : node - 균형 인수를 계산할 노드 
    * 결과값 : 균형 인수(왼쪽 서브트리 높이 - 오른쪽 서브트리 높이)
    */
-  int GetBalanceFactor(Node<T> *node) {
+  int GetBalanceFactor(NodeType *node) {
     if (node == nullptr)
       return 0;
     // 왼쪽 서브트리 높이 - 오른쪽 서브트리 높이
@@ -281,12 +1094,12 @@ private:
    *  moved_node  C        A  moved_node
    *
    */
-  Node<T> *LeftRotate(Node<T> *node) {
+  NodeType *LeftRotate(NodeType *node) {
     // node: 회전 전의 루트 노드 (불균형이 발생한 노드)
     // new_root: node의 오른쪽 자식 노드 (회전 후 새로운 루트 노드가 됨)
     // moved_node: new_root의 왼쪽 자식 노드 (회전 과정에서 위치가 변경되는 서브트리)
-    Node<T> *new_root = node->GetRight();
-    Node<T> *moved_node = new_root->GetLeft();
+    NodeType *new_root = node->GetRight();
+    NodeType *moved_node = new_root->GetLeft();
 
     new_root->SetLeft(node);
     node->SetRight(moved_node);
@@ -304,8 +1117,9 @@ private:
       } else {
         new_root->GetParent()->SetRight(new_root);
       }
-    } else {
+    } else if (node == this->root_) {
       // 회전한 노드가 루트였던 경우, 루트를 새로운 루트로 설정
+      // (일괄 연산 중 분리된 서브트리의 루트는 트리의 루트가 아님)
       this->root_ = new_root;
     }
 
@@ -336,12 +1150,12 @@ private:
    *    A  moved_node         moved_node  C
    *
    */
-  Node<T> *RightRotate(Node<T> *node) {
+  NodeType *RightRotate(NodeType *node) {
     // node: 회전 전의 루트 노드 (불균형이 발생한 노드)
     // new_root: node의 왼쪽 자식 노드 (회전 후 새로운 루트 노드가 됨)
     // moved_node: new_root의 오른쪽 자식 노드 (회전 과정에서 위치가 변경되는 서브트리)
-    Node<T> *new_root = node->GetLeft();
-    Node<T> *moved_node = new_root->GetRight();
+    NodeType *new_root = node->GetLeft();
+    NodeType *moved_node = new_root->GetRight();
 
     new_root->SetRight(node);
     node->SetLeft(moved_node);
@@ -359,8 +1173,9 @@ private:
       } else {
         new_root->GetParent()->SetRight(new_root);
       }
-    } else {
+    } else if (node == this->root_) {
       // 회전한 노드가 루트였던 경우, 루트를 새로운 루트로 설정
+      // (일괄 연산 중 분리된 서브트리의 루트는 트리의 루트가 아님)
       this->root_ = new_root;
     }
 
@@ -0,0 +1,514 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef BTREE_SET_H_
+#define BTREE_SET_H_
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * B-tree 집합 클래스
+ * 기능 : 노드 하나에 여러 키를 저장하는 B-tree로 트리 높이와 포인터 추적 횟수를 줄인 집합
+ * 설명 :
+ * - 노드의 키 배열은 int 기준 64바이트(16칸, 최대 15개 키)이며, 자식마다 서브트리 크기를 저장하여 순위 질의 지원
+ *   (서브트리 크기와 자식 포인터를 더한 노드 전체는 int 기준 약 264바이트로 캐시 라인 4~5개를 차지하지만,
+ *    노드 안의 탐색은 키 배열만 읽음)
+ * - int 키는 SSE2로 노드 안의 키를 4개씩 한 번에 비교
+ * - 삽입은 내려가며 가득 찬 자식을 미리 나누고, 삭제는 내려가며 키가 최소인 자식을 미리 채우므로 한 번만 내려감
+ * - Insert, Erase, Find, Rank, Size, Ancestor, Average는 Set과 같은 이름과 반환 형식을 사용하므로 SetAdapter로 감쌀 수 있음
+ *   (모든 리프의 깊이가 같으므로 노드의 깊이 + 높이는 항상 트리의 높이와 같음)
+ */
+template <typename T> class BTreeSet {
+public:
+  using value_type = T;
+
+  BTreeSet() : root_(nullptr), size_(0), height_(0) {}
+  BTreeSet(const BTreeSet &) = delete;
+  BTreeSet &operator=(const BTreeSet &) = delete;
+  ~BTreeSet() { Delete(); }
+
+  // 추가 기능
+  void Delete() {
+    DeleteTree(root_);
+    root_ = nullptr;
+    size_ = 0;
+    height_ = 0;
+  }
+
+  // 기본 기능
+  bool Empty() const { return root_ == nullptr; }
+  int Size() const { return size_; }
+  int Height() const { return root_ ? height_ : -1; }
+  // { 키 포인터, 깊이 + 높이 }, 키가 없으면 { nullptr, 0 }
+  std::pair<const T *, int> Find(T key) const;
+  int Insert(T key);
+
+  // 고급 기능
+  std::pair<int, int> Rank(T key) const;
+  // k번째로 작은 키 (1부터 시작), 범위를 벗어나면 nullptr
+  const T *Select(int k) const;
+  int Erase(T key);
+  std::pair<int, int> Ancestor(T key) const;
+  int Average(T key) const;
+
+private:
+  // 최소 차수 : 루트가 아닌 노드는 kMinDegree - 1개 이상 2 * kMinDegree - 1개 이하의 키를 가짐
+  static constexpr int kMinDegree = 8;
+  static constexpr int kMaxKeys = 2 * kMinDegree - 1;
+  // SIMD 비교를 4개 단위로 하기 위해 키 배열을 한 칸 더 둠
+  static constexpr int kKeySlots = kMaxKeys + 1;
+
+  struct Node {
+    int count = 0;                       // 키 개수
+    bool leaf = true;                    // 리프 여부
+    T keys[kKeySlots] = {};              // 정렬된 키
+    int sizes[kMaxKeys + 1] = {};        // 자식 서브트리의 키 개수
+    Node *children[kMaxKeys + 1] = {};   // 자식 노드
+  };
+
+  /**
+   * 기능 : 노드 안에서 key보다 작은 키의 개수를 세는 함수
+   * 동작 : int 키는 SSE2로 4개씩 비교한 결과를 비트 마스크로 모아 개수를 세고, 그 외에는 앞에서부터 비교
+   * 입력값 : node - 탐색할 노드, key - 기준 키
+   * 결과값 : key 이상인 첫 키의 위치
+   */
+  static int Position(const Node *node, const T &key) {
+#if defined(__SSE2__)
+    if constexpr (std::is_same<T, int>::value) {
+      __m128i needle = _mm_set1_epi32(key);
+      unsigned mask = 0;
+      for (int i = 0; i < kKeySlots; i += 4) {
+        __m128i block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys + i));
+        __m128i less = _mm_cmplt_epi32(block, needle);
+        mask |= static_cast<unsigned>(
+                    _mm_movemask_ps(_mm_castsi128_ps(less)))
+                << i;
+      }
+      return __builtin_popcount(mask & ((1u << node->count) - 1));
+    }
+#endif
+    int pos = 0;
+    while (pos < node->count && node->keys[pos] < key)
+      pos++;
+    return pos;
+  }
+
+  // 서브트리의 키 개수
+  static int SubtreeSize(const Node *node) {
+    int size = node->count;
+    if (!node->leaf)
+      for (int i = 0; i <= node->count; i++)
+        size += node->sizes[i];
+    return size;
+  }
+
+  void SplitChild(Node *parent, int index);
+  void MergeChildren(Node *parent, int index);
+  int FillChild(Node *parent, int index);
+  void EraseFrom(Node *node, const T &key);
+  void DeleteTree(Node *node);
+
+  Node *root_;  // 루트 노드
+  int size_;    // 키 개수
+  int height_;  // 트리 높이 (리프만 있으면 1)
+};
+
+/**
+ * 기능 : 특정 키 값을 찾는 함수
+ * 동작 : 각 노드에서 key 이상인 첫 키의 위치를 구하고, 같으면 반환하고 아니면 그 위치의 자식으로 내려감
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 키 포인터, 깊이 + 높이 }, 키가 없으면 { nullptr, 0 }
+ */
+template <typename T>
+std::pair<const T *, int> BTreeSet<T>::Find(T key) const {
+  for (const Node *node = root_; node;) {
+    int pos = Position(node, key);
+    if (pos < node->count && node->keys[pos] == key)
+      return {&node->keys[pos], height_};
+    node = node->leaf ? nullptr : node->children[pos];
+  }
+  return {nullptr, 0};
+}
+
+/**
+ * 기능 : 특정 키 값의 깊이 + 높이와 랭크를 계산하는 함수
+ * 동작 : 내려가며 지나친 왼쪽 키와 왼쪽 자식 서브트리 크기를 누적
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 깊이 + 높이, 랭크 }, 키가 없으면 { 0, 0 }
+ */
+template <typename T> std::pair<int, int> BTreeSet<T>::Rank(T key) const {
+  int cur_rank = 0;
+  for (const Node *node = root_; node;) {
+    int pos = Position(node, key);
+    cur_rank += pos;
+    if (!node->leaf)
+      for (int i = 0; i < pos; i++)
+        cur_rank += node->sizes[i];
+    if (pos < node->count && node->keys[pos] == key) {
+      if (!node->leaf)
+        cur_rank += node->sizes[pos];
+      return {height_, cur_rank + 1};
+    }
+    node = node->leaf ? nullptr : node->children[pos];
+  }
+  return {0, 0};
+}
+
+template <typename T> const T *BTreeSet<T>::Select(int k) const {
+  if (k < 1 || k > size_)
+    return nullptr;
+  const Node *node = root_;
+  while (!node->leaf) {
+    int i = 0;
+    for (;; i++) {
+      if (k <= node->sizes[i])
+        break;
+      k -= node->sizes[i];
+      if (k == 1)
+        return &node->keys[i];
+      k--;
+    }
+    node = node->children[i];
+  }
+  return &node->keys[k - 1];
+}
+
+/**
+ * 기능 : 특정 키의 깊이와 높이의 합과 조상 노드 키 값의 합 계산
+ * 동작 : 키를 찾아 내려가며 지나친 노드(키가 있는 노드의 조상)의 모든 키를 합산
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 깊이+높이, 조상 노드 키 값의 합 } (키가 루트 노드에 있으면 합은 0), 키가 없으면 { 0, 0 }
+ */
+template <typename T> std::pair<int, int> BTreeSet<T>::Ancestor(T key) const {
+  int sum = 0;
+  for (const Node *node = root_; node;) {
+    int pos = Position(node, key);
+    if (pos < node->count && node->keys[pos] == key)
+      return {height_, sum};
+    if (node->leaf)
+      break;
+    for (int i = 0; i < node->count; i++)
+      sum += node->keys[i];
+    node = node->children[pos];
+  }
+  return {0, 0};
+}
+
+/**
+ * 기능 : 특정 키가 있는 노드의 부분 트리 내 키 값의 산술평균 계산
+ * 동작 : 그 노드에서 가장 왼쪽 자식과 가장 오른쪽 자식을 따라 내려가 최솟값과 최댓값을 구해 평균 계산
+ * 입력값 : key - 부분 트리의 루트 노드에 있는 키 값
+ * 결과값 : 부분 트리 최솟값과 최댓값의 산술평균, 키가 없으면 0
+ */
+template <typename T> int BTreeSet<T>::Average(T key) const {
+  for (const Node *node = root_; node;) {
+    int pos = Position(node, key);
+    if (pos < node->count && node->keys[pos] == key) {
+      const Node *min_node = node;
+      while (!min_node->leaf)
+        min_node = min_node->children[0];
+      const Node *max_node = node;
+      while (!max_node->leaf)
+        max_node = max_node->children[max_node->count];
+      return (min_node->keys[0] + max_node->keys[max_node->count - 1]) / 2;
+    }
+    node = node->leaf ? nullptr : node->children[pos];
+  }
+  return 0;
+}
+
+/**
+ * 기능 : B-tree 키 삽입 함수
+ * 동작 : 루트부터 내려가며 가득 찬 자식을 미리 나누고 지나는 자식의 서브트리 크기를 1 늘린 뒤, 리프에 키를 넣음
+ * 입력값 : key - 삽입할 키 값
+ * 결과값 : 삽입된 노드 또는 이미 있던 같은 키의 노드의 깊이와 높이의 합 (그 키가 루트 노드에 있으면 0)
+ */
+template <typename T> int BTreeSet<T>::Insert(T key) {
+  if (Find(key).first) {
+    int pos = Position(root_, key);
+    return pos < root_->count && root_->keys[pos] == key ? 0 : height_;
+  }
+  if (!root_) {
+    root_ = new Node;
+    height_ = 1;
+  } else if (root_->count == kMaxKeys) {
+    // 루트가 가득 차면 새 루트 아래로 나누어 높이를 1 늘림
+    Node *new_root = new Node;
+    new_root->leaf = false;
+    new_root->children[0] = root_;
+    new_root->sizes[0] = size_;
+    root_ = new_root;
+    SplitChild(new_root, 0);
+    height_++;
+  }
+
+  Node *node = root_;
+  while (!node->leaf) {
+    int pos = Position(node, key);
+    if (node->children[pos]->count == kMaxKeys) {
+      SplitChild(node, pos);
+      if (node->keys[pos] < key)
+        pos++;
+    }
+    node->sizes[pos]++;
+    node = node->children[pos];
+  }
+
+  int pos = Position(node, key);
+  for (int i = node->count; i > pos; i--)
+    node->keys[i] = std::move(node->keys[i - 1]);
+  node->keys[pos] = std::move(key);
+  node->count++;
+  size_++;
+  return height_;
+}
+
+/**
+ * 기능 : B-tree 키 삭제 함수
+ * 동작 : 키가 있으면 루트부터 한 번 내려가며 삭제하고, 루트의 키가 모두 빠지면 높이를 1 줄임
+ * 입력값 : key - 삭제할 키 값
+ * 결과값 : 삭제된 노드의 깊이와 높이의 합, 노드가 없는 경우 0
+ */
+template <typename T> int BTreeSet<T>::Erase(T key) {
+  if (!Find(key).first)
+    return 0;
+  int sum = height_;
+  EraseFrom(root_, key);
+  size_--;
+  if (root_->count == 0) {
+    Node *old_root = root_;
+    root_ = root_->leaf ? nullptr : root_->children[0];
+    delete old_root;
+    height_--;
+  }
+  return sum;
+}
+
+/**
+ * 기능 : 가득 찬 자식 노드를 둘로 나누는 함수
+ * 동작 : 자식의 가운데 키를 부모로 올리고, 뒤쪽 절반의 키와 자식을 새 노드로 옮김
+ * 입력값 : parent - 가득 차지 않은 부모 노드, index - 나눌 자식의 위치
+ * 결과값 : 없음
+ */
+template <typename T> void BTreeSet<T>::SplitChild(Node *parent, int index) {
+  Node *child = parent->children[index];
+  Node *sibling = new Node;
+  sibling->leaf = child->leaf;
+  sibling->count = kMinDegree - 1;
+  for (int i = 0; i < kMinDegree - 1; i++)
+    sibling->keys[i] = std::move(child->keys[i + kMinDegree]);
+  if (!child->leaf) {
+    for (int i = 0; i < kMinDegree; i++) {
+      sibling->children[i] = child->children[i + kMinDegree];
+      sibling->sizes[i] = child->sizes[i + kMinDegree];
+    }
+  }
+  child->count = kMinDegree - 1;
+
+  for (int i = parent->count; i > index; i--) {
+    parent->children[i + 1] = parent->children[i];
+    parent->sizes[i + 1] = parent->sizes[i];
+    parent->keys[i] = std::move(parent->keys[i - 1]);
+  }
+  parent->keys[index] = std::move(child->keys[kMinDegree - 1]);
+  parent->children[index + 1] = sibling;
+  parent->count++;
+  parent->sizes[index] = SubtreeSize(child);
+  parent->sizes[index + 1] = SubtreeSize(sibling);
+}
+
+/**
+ * 기능 : 두 자식을 하나로 합치는 함수
+ * 동작 : index번째 자식 뒤에 부모의 index번째 키와 index + 1번째 자식의 키, 자식을 이어 붙임
+ * 입력값 : parent - 부모 노드, index - 합칠 왼쪽 자식의 위치 (두 자식 모두 kMinDegree - 1개의 키를 가짐)
+ * 결과값 : 없음
+ */
+template <typename T>
+void BTreeSet<T>::MergeChildren(Node *parent, int index) {
+  Node *left = parent->children[index];
+  Node *right = parent->children[index + 1];
+  left->keys[left->count] = std::move(parent->keys[index]);
+  for (int i = 0; i < right->count; i++)
+    left->keys[left->count + 1 + i] = std::move(right->keys[i]);
+  if (!left->leaf) {
+    for (int i = 0; i <= right->count; i++) {
+      left->children[left->count + 1 + i] = right->children[i];
+      left->sizes[left->count + 1 + i] = right->sizes[i];
+    }
+  }
+  left->count += right->count + 1;
+
+  for (int i = index; i < parent->count - 1; i++) {
+    parent->keys[i] = std::move(parent->keys[i + 1]);
+    parent->children[i + 1] = parent->children[i + 2];
+    parent->sizes[i + 1] = parent->sizes[i + 2];
+  }
+  parent->count--;
+  parent->sizes[index] = SubtreeSize(left);
+  delete right;
+}
+
+/**
+ * 기능 : 내려갈 자식이 최소 개수의 키만 가지면 미리 채우는 함수
+ * 동작 : 형제가 여유 키를 가지면 부모를 거쳐 키 하나를 빌려오고, 아니면 형제와 합침
+ * 입력값 : parent - 부모 노드, index - 내려갈 자식의 위치
+ * 결과값 : 채운 뒤 내려갈 자식의 위치 (왼쪽 형제와 합치면 1 줄어듦)
+ */
+template <typename T> int BTreeSet<T>::FillChild(Node *parent, int index) {
+  Node *child = parent->children[index];
+  if (child->count >= kMinDegree)
+    return index;
+
+  if (index > 0 && parent->children[index - 1]->count >= kMinDegree) {
+    // 왼쪽 형제의 마지막 키를 부모로, 부모의 키를 자식의 맨 앞으로
+    Node *left = parent->children[index - 1];
+    for (int i = child->count; i > 0; i--)
+      child->keys[i] = std::move(child->keys[i - 1]);
+    child->keys[0] = std::move(parent->keys[index - 1]);
+    if (!child->leaf) {
+      for (int i = child->count + 1; i > 0; i--) {
+        child->children[i] = child->children[i - 1];
+        child->sizes[i] = child->sizes[i - 1];
+      }
+      child->children[0] = left->children[left->count];
+      child->sizes[0] = left->sizes[left->count];
+    }
+    parent->keys[index - 1] = std::move(left->keys[left->count - 1]);
+    left->count--;
+    child->count++;
+    parent->sizes[index - 1] = SubtreeSize(left);
+    parent->sizes[index] = SubtreeSize(child);
+    return index;
+  }
+
+  if (index < parent->count &&
+      parent->children[index + 1]->count >= kMinDegree) {
+    // 오른쪽 형제의 첫 키를 부모로, 부모의 키를 자식의 맨 뒤로
+    Node *right = parent->children[index + 1];
+    child->keys[child->count] = std::move(parent->keys[index]);
+    if (!child->leaf) {
+      child->children[child->count + 1] = right->children[0];
+      child->sizes[child->count + 1] = right->sizes[0];
+    }
+    parent->keys[index] = std::move(right->keys[0]);
+    for (int i = 0; i < right->count - 1; i++)
+      right->keys[i] = std::move(right->keys[i + 1]);
+    if (!right->leaf) {
+      for (int i = 0; i < right->count; i++) {
+        right->children[i] = right->children[i + 1];
+        right->sizes[i] = right->sizes[i + 1];
+      }
+    }
+    right->count--;
+    child->count++;
+    parent->sizes[index] = SubtreeSize(child);
+    parent->sizes[index + 1] = SubtreeSize(right);
+    return index;
+  }
+
+  // 빌려올 수 없으면 형제와 합침
+  if (index < parent->count) {
+    MergeChildren(parent, index);
+    return index;
+  }
+  MergeChildren(parent, index - 1);
+  return index - 1;
+}
+
+/**
+ * 기능 : 서브트리에서 키를 삭제하는 함수
+ * 동작 : 내부 노드의 키는 선임자/후임자로 바꾸거나 두 자식을 합친 뒤 자식에서 삭제하고,
+ *        내려가기 전에 자식이 kMinDegree개 이상의 키를 갖도록 채움
+ * 입력값 : node - 루트이거나 kMinDegree개 이상의 키를 가진 노드, key - 서브트리에 있는 삭제할 키
+ * 결과값 : 없음
+ */
+template <typename T> void BTreeSet<T>::EraseFrom(Node *node, const T &key) {
+  while (true) {
+    int pos = Position(node, key);
+    bool found = pos < node->count && node->keys[pos] == key;
+
+    if (node->leaf) {
+      // 1. 리프에서는 키를 바로 제거
+      for (int i = pos; i < node->count - 1; i++)
+        node->keys[i] = std::move(node->keys[i + 1]);
+      node->count--;
+      return;
+    }
+
+    if (found) {
+      Node *left = node->children[pos];
+      Node *right = node->children[pos + 1];
+      if (left->count >= kMinDegree) {
+        // 2.1 왼쪽 자식이 여유가 있으면 선임자로 바꾸고 왼쪽에서 선임자 삭제
+        const Node *pred = left;
+        while (!pred->leaf)
+          pred = pred->children[pred->count];
+        node->keys[pos] = pred->keys[pred->count - 1];
+        EraseFrom(left, node->keys[pos]);
+        node->sizes[pos]--;
+        return;
+      }
+      if (right->count >= kMinDegree) {
+        // 2.2 오른쪽 자식이 여유가 있으면 후임자로 바꾸고 오른쪽에서 후임자 삭제
+        const Node *succ = right;
+        while (!succ->leaf)
+          succ = succ->children[0];
+        node->keys[pos] = succ->keys[0];
+        EraseFrom(right, node->keys[pos]);
+        node->sizes[pos + 1]--;
+        return;
+      }
+      // 2.3 두 자식을 키와 함께 합친 뒤 합친 자식에서 삭제
+      MergeChildren(node, pos);
+    } else {
+      // 3. 내려갈 자식을 미리 채움
+      pos = FillChild(node, pos);
+    }
+
+    // 합치기/채우기로 node의 키가 모두 빠진 루트는 Erase에서 정리
+    node->sizes[pos]--;
+    node = node->children[pos];
+  }
+}
+
+// 서브트리의 모든 노드 해제
+template <typename T> void BTreeSet<T>::DeleteTree(Node *node) {
+  if (node) {
+    if (!node->leaf)
+      for (int i = 0; i <= node->count; i++)
+        DeleteTree(node->children[i]);
+    delete node;
+  }
+}
+
+#endif
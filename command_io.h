@@ -0,0 +1,365 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+
+#ifndef COMMAND_IO_H_
+#define COMMAND_IO_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define COMMAND_IO_MMAP 1
+#endif
+
+/**
+ * 입력 버퍼 클래스
+ * 기능 : 명령어 스트림을 큰 블록 단위로 읽어 공백으로 구분된 토큰과 정수를 반환
+ * 설명 :
+ * - 파일 경로가 주어지면 mmap으로 파일 전체를 매핑하고, 실패하거나 stdin이면 블록 단위로 읽음
+ * - ReadWord가 반환한 토큰은 다음 읽기 전까지만 유효
+ */
+class InputBuffer {
+public:
+  // path가 nullptr이면 stdin에서 읽음
+  explicit InputBuffer(const char *path = nullptr)
+      : cur_(nullptr), end_(nullptr), file_(nullptr), map_(nullptr),
+        map_size_(0) {
+    if (!path) {
+      file_ = stdin;
+      return;
+    }
+#ifdef COMMAND_IO_MMAP
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0) {
+      void *map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED) {
+        map_ = map;
+        map_size_ = info.st_size;
+        madvise(map_, map_size_, MADV_SEQUENTIAL);
+        cur_ = static_cast<const char *>(map_);
+        end_ = cur_ + map_size_;
+      }
+    }
+    if (fd >= 0)
+      close(fd);
+    if (map_)
+      return;
+#endif
+    file_ = std::fopen(path, "rb");
+  }
+  InputBuffer(const InputBuffer &) = delete;
+  InputBuffer &operator=(const InputBuffer &) = delete;
+  ~InputBuffer() {
+#ifdef COMMAND_IO_MMAP
+    if (map_)
+      munmap(map_, map_size_);
+#endif
+    if (file_ && file_ != stdin)
+      std::fclose(file_);
+  }
+
+  // 파일을 열었는지 여부
+  bool IsOpen() const { return map_ || file_; }
+
+  /**
+   * 기능 : 공백으로 구분된 다음 토큰을 읽는 함수
+   * 동작 : 공백을 건너뛴 뒤 다음 공백까지를 토큰으로 하며, 버퍼 끝에 걸친 토큰은 남은 부분을 앞으로 옮기고 이어서 읽음
+   * 입력값 : word - 토큰을 받을 변수
+   * 결과값 : 토큰을 읽었는지 여부 (입력 끝이면 false)
+   */
+  bool ReadWord(std::string_view &word) {
+    for (;;) {
+      while (cur_ < end_ && IsSpace(*cur_))
+        cur_++;
+      if (cur_ < end_)
+        break;
+      if (!Refill())
+        return false;
+    }
+    size_t length = 0;
+    for (;;) {
+      while (cur_ + length < end_ && !IsSpace(cur_[length]))
+        length++;
+      if (cur_ + length < end_ || !Refill())
+        break;
+    }
+    word = std::string_view(cur_, length);
+    cur_ += length;
+    return true;
+  }
+
+  // 다음 토큰을 10진 정수로 읽음 (토큰이 없으면 false)
+  bool ReadInt(int &value) {
+    std::string_view word;
+    if (!ReadWord(word))
+      return false;
+    value = ParseInt(word);
+    return true;
+  }
+
+  // size 바이트를 그대로 읽음 (남은 바이트가 부족하면 false)
+  bool ReadBytes(void *dest, size_t size) {
+    while (static_cast<size_t>(end_ - cur_) < size)
+      if (!Refill())
+        return false;
+    std::memcpy(dest, cur_, size);
+    cur_ += size;
+    return true;
+  }
+
+  // 리틀 엔디언 4바이트 정수를 읽음
+  bool ReadUint32(uint32_t &value) {
+    unsigned char bytes[4];
+    if (!ReadBytes(bytes, 4))
+      return false;
+    value = DecodeUint32(bytes);
+    return true;
+  }
+
+  // 리틀 엔디언 4바이트를 정수로 변환
+  static uint32_t DecodeUint32(const unsigned char *bytes) {
+    return bytes[0] | bytes[1] << 8 | bytes[2] << 16 |
+           static_cast<uint32_t>(bytes[3]) << 24;
+  }
+
+  // 부호와 숫자로 된 토큰을 정수로 변환 (숫자가 아닌 문자에서 멈춤)
+  static int ParseInt(std::string_view word) {
+    size_t i = 0;
+    bool negative = !word.empty() && word[0] == '-';
+    if (negative || (!word.empty() && word[0] == '+'))
+      i++;
+    unsigned value = 0;
+    for (; i < word.size() && word[i] >= '0' && word[i] <= '9'; i++)
+      value = value * 10 + (word[i] - '0');
+    return static_cast<int>(negative ? 0u - value : value);
+  }
+
+private:
+  static constexpr size_t kBlockSize = 1 << 20; // 한 번에 읽는 크기
+
+  static bool IsSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' ||
+           c == '\f';
+  }
+
+  /**
+   * 기능 : 버퍼를 다시 채우는 함수
+   * 동작 : 아직 읽지 않은 부분을 버퍼 앞으로 옮기고, 뒤에 다음 블록을 이어서 읽음 (토큰이 블록보다 길면 버퍼를 늘림)
+   * 입력값 : 없음
+   * 결과값 : 새로 읽은 바이트가 있는지 여부
+   */
+  bool Refill() {
+    if (!file_)
+      return false;
+    size_t remain = end_ - cur_;
+    size_t offset = remain ? cur_ - buffer_.data() : 0;
+    if (buffer_.size() < remain + kBlockSize / 2)
+      buffer_.resize(remain + kBlockSize);
+    std::memmove(buffer_.data(), buffer_.data() + offset, remain);
+    size_t read =
+        std::fread(buffer_.data() + remain, 1, buffer_.size() - remain, file_);
+    cur_ = buffer_.data();
+    end_ = cur_ + remain + read;
+    return read > 0;
+  }
+
+  const char *cur_;          // 다음에 읽을 위치
+  const char *end_;          // 읽은 데이터의 끝
+  std::vector<char> buffer_; // 블록 단위로 읽을 때의 버퍼
+  std::FILE *file_;          // 블록 단위로 읽을 파일 (mmap이면 nullptr)
+  void *map_;                // mmap으로 매핑한 영역
+  size_t map_size_;          // 매핑한 영역의 크기
+};
+
+/**
+ * 출력 버퍼 클래스
+ * 기능 : 결과를 하나의 큰 버퍼에 모아 한 번에 출력
+ * 설명 : 정수는 std::to_chars로 변환하며, 버퍼가 kFlushSize를 넘으면 파일에 씀
+ *        (파일이 없으면 메모리에만 모으고, View로 모은 내용을 읽음)
+ */
+class OutputBuffer {
+public:
+  explicit OutputBuffer(std::FILE *file = nullptr) : file_(file) {
+    if (file_)
+      buffer_.reserve(kFlushSize + kMaxWrite);
+  }
+  OutputBuffer(const OutputBuffer &) = delete;
+  OutputBuffer &operator=(const OutputBuffer &) = delete;
+  ~OutputBuffer() { Flush(); }
+
+  void WriteInt(long long value) {
+    size_t size = buffer_.size();
+    buffer_.resize(size + kMaxWrite);
+    char *end = std::to_chars(buffer_.data() + size, buffer_.data() + size +
+                                                         kMaxWrite, value)
+                    .ptr;
+    buffer_.resize(end - buffer_.data());
+    FlushIfFull();
+  }
+  void WriteChar(char c) {
+    buffer_.push_back(c);
+    FlushIfFull();
+  }
+  void Write(std::string_view text) {
+    buffer_.insert(buffer_.end(), text.begin(), text.end());
+    FlushIfFull();
+  }
+  // 리틀 엔디언 4바이트 정수로 씀
+  void WriteUint32(uint32_t value) {
+    char bytes[4] = {static_cast<char>(value), static_cast<char>(value >> 8),
+                     static_cast<char>(value >> 16),
+                     static_cast<char>(value >> 24)};
+    Write(std::string_view(bytes, 4));
+  }
+
+  // 아직 출력하지 않은 내용
+  std::string_view View() const {
+    return std::string_view(buffer_.data(), buffer_.size());
+  }
+
+  // 모은 내용을 파일에 씀 (파일이 없으면 아무것도 하지 않음)
+  void Flush() {
+    if (!file_)
+      return;
+    if (!buffer_.empty())
+      std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    buffer_.clear();
+    std::fflush(file_);
+  }
+
+private:
+  static constexpr size_t kFlushSize = 1 << 20; // 이 크기를 넘으면 출력
+  static constexpr size_t kMaxWrite = 24;       // 정수 하나의 최대 길이
+
+  void FlushIfFull() {
+    if (buffer_.size() >= kFlushSize)
+      Flush();
+  }
+
+  std::vector<char> buffer_; // 아직 출력하지 않은 내용
+  std::FILE *file_;          // 출력할 파일
+};
+
+// 드라이버 명령어 종류 (값은 이진 형식의 opcode이므로 순서를 바꾸지 않음)
+enum class Command : uint8_t {
+  kInsert,
+  kEmpty,
+  kFind,
+  kSize,
+  kRank,
+  kErase,
+  kHeight,
+  kAncestor,
+  kAverage,
+  kUnknown,
+};
+
+// word가 name과 같으면 command, 아니면 Command::kUnknown
+inline Command MatchCommand(std::string_view word, std::string_view name,
+                            Command command) {
+  return word == name ? command : Command::kUnknown;
+}
+
+/**
+ * 기능 : 명령어 토큰을 종류로 변환하는 함수
+ * 동작 : 첫 글자로 분기하고 후보 하나와만 비교 (E, A로 시작하는 명령어는 두 번째 글자 또는 길이로 구분)
+ * 입력값 : word - 명령어 토큰
+ * 결과값 : 명령어 종류, 해당하는 명령어가 없으면 Command::kUnknown
+ */
+inline Command ParseCommand(std::string_view word) {
+  switch (word.empty() ? '\0' : word[0]) {
+  case 'I':
+    return MatchCommand(word, "Insert", Command::kInsert);
+  case 'E':
+    if (word.size() > 1 && word[1] == 'm')
+      return MatchCommand(word, "Empty", Command::kEmpty);
+    return MatchCommand(word, "Erase", Command::kErase);
+  case 'F':
+    return MatchCommand(word, "Find", Command::kFind);
+  case 'S':
+    return MatchCommand(word, "Size", Command::kSize);
+  case 'R':
+    return MatchCommand(word, "Rank", Command::kRank);
+  case 'H':
+    return MatchCommand(word, "Height", Command::kHeight);
+  case 'A':
+    if (word.size() == 8)
+      return MatchCommand(word, "Ancestor", Command::kAncestor);
+    return MatchCommand(word, "Average", Command::kAverage);
+  default:
+    return Command::kUnknown;
+  }
+}
+
+// 명령어 종류의 텍스트 이름 (Command::kUnknown이면 빈 문자열)
+inline std::string_view CommandName(Command command) {
+  static constexpr std::string_view kNames[] = {
+      "Insert", "Empty", "Find",     "Size",    "Rank",
+      "Erase",  "Height", "Ancestor", "Average", ""};
+  return kNames[static_cast<int>(std::min(command, Command::kUnknown))];
+}
+
+// 정수 인자를 받는 명령어인지 여부
+inline bool HasOperand(Command command) {
+  return command != Command::kEmpty && command != Command::kSize &&
+         command != Command::kHeight && command != Command::kUnknown;
+}
+
+/**
+ * 이진 명령어 형식 (정수는 모두 리틀 엔디언)
+ * - 입력 : kBinaryMagic(4바이트), T(u32), 테스트 케이스마다 Q(u32)와 명령어 Q개
+ * - 명령어 : opcode(u8, Command 값) + 인자(i32), 인자가 없는 명령어도 0을 씀
+ * - 출력 : 명령어마다 결과 정수(i32) ResultWidth(opcode)개
+ *   (Rank는 키가 없으면 0 0, 알 수 없는 opcode는 결과 없음)
+ */
+constexpr char kBinaryMagic[4] = {'A', 'V', 'B', '1'};
+constexpr size_t kBinaryCommandSize = 5;
+
+// 이진 출력에서 명령어 하나의 결과 정수 개수
+inline int ResultWidth(Command command) {
+  switch (command) {
+  case Command::kRank:
+  case Command::kAncestor:
+    return 2;
+  case Command::kUnknown:
+    return 0;
+  default:
+    return command < Command::kUnknown ? 1 : 0;
+  }
+}
+
+#endif
@@ -0,0 +1,456 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef COMPACT_AVL_TREE_H_
+#define COMPACT_AVL_TREE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * 인덱스 연결 AVL 트리 클래스
+ * 기능 : 노드를 연속된 배열에 저장하고 32-bit 인덱스로 연결하는 AVL 트리
+ * 설명 :
+ * - 탐색에 쓰이는 키와 자식(hot)을, 부모와 랭크(cold)와 분리하여 저장
+ * - 높이는 1바이트로 저장하며, 삭제 시 마지막 노드를 빈 자리로 옮겨 배열을 연속으로 유지
+ * - AvlTree<T>와 같은 질의 결과(깊이 + 높이, 랭크)를 반환
+ */
+template <typename T> class CompactAvlTree {
+public:
+  // 노드가 없음을 나타내는 인덱스
+  static constexpr uint32_t kNil = UINT32_MAX;
+
+  CompactAvlTree() : root_(kNil) {}
+
+  // 추가 기능
+  void Delete() {
+    hot_.clear();
+    heights_.clear();
+    cold_.clear();
+    root_ = kNil;
+  }
+  // count개의 노드를 재할당 없이 저장할 수 있도록 미리 확보
+  void Reserve(int count) {
+    hot_.reserve(count);
+    heights_.reserve(count);
+    cold_.reserve(count);
+  }
+  // Find가 반환한 인덱스의 키 값 (삭제 연산 이후에는 인덱스가 바뀔 수 있음)
+  const T &GetKey(uint32_t index) const { return hot_[index].key; }
+
+  // 기본 기능
+  bool Empty() const { return root_ == kNil; }
+  int Size() const { return static_cast<int>(hot_.size()); }
+  int Height() const { return root_ != kNil ? heights_[root_] : -1; }
+  std::pair<uint32_t, int> Find(T key) const;
+  std::pair<int, int> Ancestor(T key) const;
+  int Average(T key) const;
+  int Insert(T key);
+
+  // 고급 기능
+  std::pair<int, int> Rank(T key) const;
+  int Erase(T key);
+
+private:
+  // 경로 스택의 최대 길이 (노드 수가 int 범위일 때 AVL 트리의 높이는 45 이하)
+  static constexpr int kMaxHeight = 64;
+
+  // 탐색 시 매번 읽는 필드 (child[0] : 왼쪽, child[1] : 오른쪽)
+  struct HotNode {
+    T key;
+    uint32_t child[2];
+  };
+
+  // 구조 변경과 순위 질의에만 쓰이는 필드
+  struct ColdNode {
+    uint32_t parent;
+    int rank;
+  };
+
+  int HeightOf(uint32_t index) const {
+    return index != kNil ? heights_[index] : 0;
+  }
+  int RankOf(uint32_t index) const {
+    return index != kNil ? cold_[index].rank : 0;
+  }
+  int GetBalanceFactor(uint32_t index) const {
+    if (index == kNil)
+      return 0;
+    return HeightOf(hot_[index].child[0]) - HeightOf(hot_[index].child[1]);
+  }
+
+  // 자식의 높이와 랭크를 기반으로 노드의 높이와 랭크를 갱신
+  void NodeUpdate(uint32_t index) {
+    uint32_t left = hot_[index].child[0];
+    uint32_t right = hot_[index].child[1];
+    heights_[index] =
+        static_cast<uint8_t>(1 + std::max(HeightOf(left), HeightOf(right)));
+    cold_[index].rank = 1 + RankOf(left) + RankOf(right);
+  }
+
+  void ReplaceChild(uint32_t old_index, uint32_t new_index);
+  uint32_t Rotate(uint32_t index, int dir);
+  uint32_t ReBalanceTree(uint32_t index);
+  void RemoveSlot(uint32_t index);
+
+  std::vector<HotNode> hot_;      // 키와 자식 인덱스
+  std::vector<uint8_t> heights_;  // 노드 높이
+  std::vector<ColdNode> cold_;    // 부모 인덱스와 랭크
+  uint32_t root_;                 // 루트 노드 인덱스
+};
+
+/**
+ * 기능 : 특정 키 값을 가진 노드의 깊이와 높이의 합을 계산
+ * 동작 : 루트부터 반복적으로 내려가며 해당 키 값을 가진 노드를 탐색
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 노드 인덱스, 깊이 + 높이 }, 노드가 없는 경우 { kNil, 0 }
+ */
+template <typename T>
+std::pair<uint32_t, int> CompactAvlTree<T>::Find(T key) const {
+  int depth = 0;
+  uint32_t index = root_;
+  while (index != kNil) {
+    const HotNode &node = hot_[index];
+    if (key < node.key) {
+      index = node.child[0];
+    } else if (key > node.key) {
+      index = node.child[1];
+    } else {
+      return {index, depth + heights_[index]};
+    }
+    depth++;
+  }
+  return {kNil, 0};
+}
+
+/**
+ * 기능 : 특정 노드의 깊이 + 높이의 합과 랭크를 계산하는 함수
+ * 동작 : 루트부터 내려가며 왼쪽 서브트리의 랭크를 누적
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 깊이 + 높이의 합, 순위 }, 노드가 없는 경우 { 0, 0 }
+ */
+template <typename T>
+std::pair<int, int> CompactAvlTree<T>::Rank(T key) const {
+  int depth = 0;
+  int cur_rank = 0;
+  uint32_t index = root_;
+  while (index != kNil) {
+    const HotNode &node = hot_[index];
+    if (key < node.key) {
+      index = node.child[0];
+    } else if (key > node.key) {
+      cur_rank += RankOf(node.child[0]) + 1;
+      index = node.child[1];
+    } else {
+      return {depth + heights_[index], cur_rank + RankOf(node.child[0]) + 1};
+    }
+    depth++;
+  }
+  return {0, 0};
+}
+
+/**
+ * 기능 : 특정 노드의 깊이와 높이의 합과 부모 노드 키 값의 합 계산
+ * 동작 : 부모 인덱스를 따라 루트까지 올라가며 키 값을 합산
+ * 입력값 : key - 찾고자 하는 노드의 키 값
+ * 결과값 : { 깊이+높이, 루트까지 부모 노드 키 값의 합 }
+ */
+template <typename T>
+std::pair<int, int> CompactAvlTree<T>::Ancestor(T key) const {
+  std::pair<uint32_t, int> found = Find(key);
+  if (found.first == kNil)
+    return {0, 0};
+
+  int sum = 0;
+  for (uint32_t index = cold_[found.first].parent; index != kNil;
+       index = cold_[index].parent)
+    sum += hot_[index].key;
+  return {found.second, sum};
+}
+
+/**
+ * 기능 : 특정 노드의 부분 트리 내 키 값의 산술평균 계산
+ * 동작 : 부분 트리에서 최솟값과 최댓값을 구해 평균 계산
+ * 입력값 : key - 부분 트리의 루트로 사용할 키 값
+ * 결과값 : 부분 트리 최솟값과 최댓값의 산술평균
+ */
+template <typename T> int CompactAvlTree<T>::Average(T key) const {
+  std::pair<uint32_t, int> found = Find(key);
+  if (found.first == kNil)
+    return 0;
+
+  uint32_t min_index = found.first;
+  while (hot_[min_index].child[0] != kNil)
+    min_index = hot_[min_index].child[0];
+  uint32_t max_index = found.first;
+  while (hot_[max_index].child[1] != kNil)
+    max_index = hot_[max_index].child[1];
+  return (hot_[min_index].key + hot_[max_index].key) / 2;
+}
+
+/**
+ * 기능 : AVL Tree Node 삽입 함수
+ * 동작 : 경로 스택을 기록하며 한 번만 내려가 노드를 배열 끝에 추가하고, 높이가 변하는 조상까지만 균형 조정
+ * 입력값 : key - 삽입할 키 값
+ * 결과값 : 삽입된 노드 또는 이미 있던 같은 키의 노드의 깊이와 높이의 합 (그 노드가 루트이면 0)
+ */
+template <typename T> int CompactAvlTree<T>::Insert(T key) {
+  uint32_t path[kMaxHeight];
+  int depth = 0;
+  int dir = 0;
+
+  // 1. 삽입 위치까지 한 번만 하강
+  uint32_t index = root_;
+  while (index != kNil) {
+    path[depth++] = index;
+    if (key < hot_[index].key) {
+      dir = 0;
+    } else if (key > hot_[index].key) {
+      dir = 1;
+    } else {
+      // 이미 있는 노드 : path에 자신까지 들어 있으므로 깊이는 depth - 1
+      return index == root_ ? 0 : depth - 1 + heights_[index];
+    }
+    index = hot_[index].child[dir];
+  }
+
+  // 2. 새 노드를 배열 끝에 추가하고 부모에 연결
+  uint32_t new_index = static_cast<uint32_t>(hot_.size());
+  uint32_t parent = depth > 0 ? path[depth - 1] : kNil;
+  hot_.push_back({key, {kNil, kNil}});
+  heights_.push_back(1);
+  cold_.push_back({parent, 1});
+  if (parent == kNil) {
+    root_ = new_index;
+    return 1;
+  }
+  hot_[parent].child[dir] = new_index;
+
+  // 3. 경로를 거슬러 올라가며 랭크 갱신, 높이가 변하는 동안만 균형 조정
+  int new_depth = depth;
+  bool retracing = true;
+  for (int i = depth - 1; i >= 0; i--) {
+    uint32_t cur = path[i];
+    cold_[cur].rank++;
+    if (!retracing)
+      continue;
+
+    int old_height = heights_[cur];
+    NodeUpdate(cur);
+    int balance = GetBalanceFactor(cur);
+    if (balance > 1 || balance < -1) {
+      uint32_t sub_root = ReBalanceTree(cur);
+      new_depth = i;
+      for (uint32_t n = new_index; n != sub_root; n = cold_[n].parent)
+        new_depth++;
+      retracing = false;
+    } else if (heights_[cur] == old_height) {
+      retracing = false;
+    }
+  }
+
+  return new_depth + heights_[new_index];
+}
+
+/**
+ * 기능 : AVL Tree Node 삭제 함수
+ * 동작 : 노드를 떼어내고 자식이 둘이면 후임자를 그 자리로 옮겨 균형 조정한 뒤, 빈 슬롯을 배열 끝 노드로 채움
+ * 입력값 : key - 삭제할 키 값
+ * 결과값 : 삭제된 노드의 깊이와 높이의 합, 노드가 없는 경우 0
+ */
+template <typename T> int CompactAvlTree<T>::Erase(T key) {
+  uint32_t path[kMaxHeight];
+  int depth = 0;
+
+  // 1. 삭제할 노드까지 한 번만 하강
+  uint32_t index = root_;
+  while (index != kNil) {
+    if (key < hot_[index].key) {
+      path[depth++] = index;
+      index = hot_[index].child[0];
+    } else if (key > hot_[index].key) {
+      path[depth++] = index;
+      index = hot_[index].child[1];
+    } else {
+      break;
+    }
+  }
+  if (index == kNil)
+    return 0;
+
+  int sum = depth + heights_[index];
+  uint32_t left = hot_[index].child[0];
+  uint32_t right = hot_[index].child[1];
+
+  if (left == kNil || right == kNil) {
+    // 2.1 자식이 하나 이하인 경우, 자식이 삭제할 노드의 자리를 대신함
+    ReplaceChild(index, left != kNil ? left : right);
+  } else {
+    // 2.2 자식이 둘인 경우, 후임자 노드를 떼어내 삭제할 노드의 자리로 옮김
+    int node_depth = depth;
+    path[depth++] = index;
+    uint32_t successor = right;
+    while (hot_[successor].child[0] != kNil) {
+      path[depth++] = successor;
+      successor = hot_[successor].child[0];
+    }
+
+    if (successor != right) {
+      uint32_t successor_parent = cold_[successor].parent;
+      uint32_t successor_right = hot_[successor].child[1];
+      hot_[successor_parent].child[0] = successor_right;
+      if (successor_right != kNil)
+        cold_[successor_right].parent = successor_parent;
+      hot_[successor].child[1] = right;
+      cold_[right].parent = successor;
+    }
+    hot_[successor].child[0] = left;
+    cold_[left].parent = successor;
+    heights_[successor] = heights_[index];
+    cold_[successor].rank = cold_[index].rank;
+    ReplaceChild(index, successor);
+    path[node_depth] = successor;
+  }
+
+  // 3. 경로를 거슬러 올라가며 랭크 갱신, 높이가 변하는 동안만 균형 조정
+  bool retracing = true;
+  for (int i = depth - 1; i >= 0; i--) {
+    uint32_t cur = path[i];
+    cold_[cur].rank--;
+    if (!retracing)
+      continue;
+
+    int old_height = heights_[cur];
+    NodeUpdate(cur);
+    int balance = GetBalanceFactor(cur);
+    if (balance > 1 || balance < -1)
+      cur = ReBalanceTree(cur);
+    if (heights_[cur] == old_height)
+      retracing = false;
+  }
+
+  // 4. 트리에서 떨어진 슬롯을 배열 끝 노드로 채움
+  RemoveSlot(index);
+  return sum;
+}
+
+/**
+ * 기능 : 부모가 가리키는 자식 노드를 교체하는 함수
+ * 동작 : old_index의 부모(없으면 루트)가 new_index를 가리키도록 하고, new_index의 부모를 설정
+ * 입력값 : old_index - 교체될 노드, new_index - 새로 연결할 노드 (kNil 가능)
+ * 결과값 : 없음
+ */
+template <typename T>
+void CompactAvlTree<T>::ReplaceChild(uint32_t old_index, uint32_t new_index) {
+  uint32_t parent = cold_[old_index].parent;
+  if (new_index != kNil)
+    cold_[new_index].parent = parent;
+
+  if (parent == kNil)
+    root_ = new_index;
+  else
+    hot_[parent].child[hot_[parent].child[0] == old_index ? 0 : 1] = new_index;
+}
+
+/**
+ * 기능 : 회전 수행 함수
+ * 동작 : dir이 0이면 왼쪽 회전(오른쪽 자식이 올라감), 1이면 오른쪽 회전(왼쪽 자식이 올라감) 수행
+ * 입력값 : index - 회전할 노드, dir - 회전 방향
+ * 결과값 : 회전 후 서브트리의 새로운 루트 노드
+ */
+template <typename T>
+uint32_t CompactAvlTree<T>::Rotate(uint32_t index, int dir) {
+  uint32_t new_root = hot_[index].child[1 - dir];
+  uint32_t moved = hot_[new_root].child[dir];
+
+  ReplaceChild(index, new_root);
+  hot_[new_root].child[dir] = index;
+  cold_[index].parent = new_root;
+  hot_[index].child[1 - dir] = moved;
+  if (moved != kNil)
+    cold_[moved].parent = index;
+
+  // 높이 및 랭크 업데이트
+  NodeUpdate(index);
+  NodeUpdate(new_root);
+  return new_root;
+}
+
+/**
+ * 기능 : 트리의 균형을 맞추기 위한 함수
+ * 동작 : 균형 인수를 계산 후, 조건에 따른 회전 수행 (AvlTree와 같은 규칙)
+ * 입력값 : index - 균형 조정을 수행할 노드
+ * 결과값 : 균형 조정된 서브트리의 새로운 루트 노드
+ */
+template <typename T>
+uint32_t CompactAvlTree<T>::ReBalanceTree(uint32_t index) {
+  int balance = GetBalanceFactor(index);
+  if (balance > 1) {
+    // LR 회전: 왼쪽 자식의 오른쪽 자식이 무거운 경우
+    if (GetBalanceFactor(hot_[index].child[0]) < 0)
+      Rotate(hot_[index].child[0], 0);
+    return Rotate(index, 1);
+  }
+  if (balance < -1) {
+    // RL 회전: 오른쪽 자식의 왼쪽 자식이 무거운 경우
+    if (GetBalanceFactor(hot_[index].child[1]) > 0)
+      Rotate(hot_[index].child[1], 1);
+    return Rotate(index, 0);
+  }
+  return index;
+}
+
+/**
+ * 기능 : 트리에서 떨어진 슬롯 제거 함수
+ * 동작 : 배열의 마지막 노드를 빈 슬롯으로 옮기고 부모와 자식의 연결을 갱신한 뒤 배열 크기를 줄임
+ * 입력값 : index - 트리에서 떨어진 노드의 인덱스
+ * 결과값 : 없음
+ */
+template <typename T> void CompactAvlTree<T>::RemoveSlot(uint32_t index) {
+  uint32_t last = static_cast<uint32_t>(hot_.size() - 1);
+  if (index != last) {
+    hot_[index] = std::move(hot_[last]);
+    heights_[index] = heights_[last];
+    cold_[index] = cold_[last];
+
+    uint32_t parent = cold_[index].parent;
+    if (parent == kNil)
+      root_ = index;
+    else
+      hot_[parent].child[hot_[parent].child[0] == last ? 0 : 1] = index;
+    for (uint32_t child : hot_[index].child)
+      if (child != kNil)
+        cold_[child].parent = index;
+  }
+  hot_.pop_back();
+  heights_.pop_back();
+  cold_.pop_back();
+}
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef COMPARE_H_
+#define COMPARE_H_
+
+#include <type_traits>
+#include <utility>
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_concepts)
+#include <compare>
+#endif
+
+// a.compare(b)가 int로 변환되는 값을 반환하는지 검사 (std::string 등)
+template <typename A, typename B, typename = void>
+struct HasCompareMember : std::false_type {};
+
+template <typename A, typename B>
+struct HasCompareMember<
+    A, B,
+    std::enable_if_t<std::is_convertible<
+        decltype(std::declval<const A &>().compare(std::declval<const B &>())),
+        int>::value>> : std::true_type {};
+
+/**
+ * 3-way 비교 정책
+ * 기능 : 두 키를 비교하여 음수(a < b), 0(a == b), 양수(a > b)를 반환
+ * 설명 :
+ * - compare 멤버가 있으면(std::string 등) 그것을 한 번 호출
+ * - 없으면 a < b를 먼저 비교하고, 거짓일 때(a >= b) b < a를 한 번 더 비교
+ *   (이 저장소의 C++17 빌드에서는 int 등 compare 멤버가 없는 키가 모두 이 경로를 사용)
+ * - C++20으로 빌드하면 <를 쓰는 대신 <=>로 한 번만 비교 (C++17에서는 컴파일되지 않는 분기)
+ * - is_transparent를 정의하므로 키와 다른 타입(예 : std::string 키와 std::string_view)으로도 탐색 가능
+ * - 다른 순서가 필요하면 같은 형식의 operator()를 가진 타입을 Set의 Compare 인자로 넘김
+ */
+struct ThreeWayCompare {
+  using is_transparent = void;
+
+  template <typename A, typename B>
+  int operator()(const A &a, const B &b) const {
+    if constexpr (HasCompareMember<A, B>::value) {
+      int order = a.compare(b);
+      return order < 0 ? -1 : (order > 0 ? 1 : 0);
+    } else if constexpr (HasCompareMember<B, A>::value) {
+      int order = b.compare(a);
+      return order < 0 ? 1 : (order > 0 ? -1 : 0);
+    } else {
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_concepts)
+      if constexpr (requires { a <=> b; }) {
+        auto order = a <=> b;
+        return order < 0 ? -1 : (order > 0 ? 1 : 0);
+      }
+#endif
+      return a < b ? -1 : (b < a ? 1 : 0);
+    }
+  }
+};
+
+#endif
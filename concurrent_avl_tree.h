@@ -0,0 +1,703 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef CONCURRENT_AVL_TREE_H_
+#define CONCURRENT_AVL_TREE_H_
+
+#include "epoch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * 동시성 AVL 트리 클래스
+ * 기능 : 여러 스레드에서 동시에 사용할 수 있는 AVL 트리
+ * 설명 :
+ * - Find, Rank, Ancestor는 잠금 없이 낙관적으로 읽고, 끝난 뒤 지나온 노드의 버전이 그대로인지 확인하여
+ *   바뀌었으면 다시 읽음 (kMaxOptimisticRetries번 실패하면 노드 잠금을 부모에서 자식 순서로 잡으며 읽고,
+ *   이때도 끝난 뒤 버전을 확인하여 위쪽에서 회전이 일어났으면 다시 읽음)
+ * - 쓰기 스레드는 노드 잠금을 부모에서 자식 순서로 잡으며 내려가고, 높이 변화와 회전이 닿지 않는
+ *   위쪽 노드의 잠금은 바로 해제하므로 서로 다른 서브트리의 삽입/삭제는 동시에 진행됨
+ * - 노드의 자식이나 높이를 바꾸는 동안에만 그 노드의 버전을 홀수로 만들어 읽기 스레드와 충돌하는 구간을 최소화
+ * - 같은 키를 쓰는 스레드끼리는 키 잠금으로 막아, 잠금 없이 확인한 키의 존재 여부가 쓰기 중에 바뀌지 않음
+ * - 서브트리 크기는 내려가면서 갱신하되 노드의 진행 중인 쓰기 수(pending)를 같이 늘리고, 노드를 연결/분리하고
+ *   높이를 고친 뒤에 줄임. 읽기 스레드는 pending이 0인 노드의 크기와 높이만 사용하므로 Rank와 Find는
+ *   같은 시점의 트리를 봄 (회전이나 후임자 이동으로 노드의 서브트리가 바뀔 때는 그 아래의 쓰기가 끝나기를 기다림)
+ * - 삭제된 노드는 EpochManager로 넘겨, 그 노드를 보고 있을 수 있는 읽기/쓰기 스레드가 모두 끝난 뒤 해제
+ * - 노드 포인터는 잠금 밖에서 유효하지 않으므로 질의는 값만 반환
+ * - AvlTree<T>와 같은 질의 결과(깊이 + 높이, 랭크, 조상 키의 합)를 반환
+ */
+template <typename T> class ConcurrentAvlTree {
+public:
+  ConcurrentAvlTree() : head_(T()), size_(0) {}
+  ConcurrentAvlTree(const ConcurrentAvlTree &) = delete;
+  ConcurrentAvlTree &operator=(const ConcurrentAvlTree &) = delete;
+  // 사용 중인 스레드가 없을 때 소멸해야 함
+  ~ConcurrentAvlTree() { DeleteTree(Child(&head_, 0)); }
+
+  // 기본 기능
+  bool Empty() const { return Size() == 0; }
+  int Size() const { return size_.load(std::memory_order_relaxed); }
+  int Height() const {
+    return Read<int>([](auto &access, const Node *head, int &height) {
+      const Node *root = Child(head, 0);
+      if (root && (!access.Add(root) || !access.Settle(root)))
+        return false;
+      height = root ? HeightOf(root) : -1;
+      return true;
+    });
+  }
+  // { 키 존재 여부, 깊이 + 높이 }
+  std::pair<bool, int> Find(T key) const;
+  std::pair<int, int> Ancestor(T key) const;
+  int Insert(T key);
+
+  // 고급 기능
+  std::pair<int, int> Rank(T key) const;
+  int Erase(T key);
+
+private:
+  // 경로 스택의 최대 길이 (노드 수가 int 범위일 때 AVL 트리의 높이는 45 이하)
+  static constexpr int kMaxHeight = 64;
+  // 잠금 없이 읽기를 시도하는 최대 횟수
+  static constexpr int kMaxOptimisticRetries = 16;
+  // 같은 키를 쓰는 스레드끼리만 막는 키 잠금의 개수
+  static constexpr size_t kKeyStripes = 64;
+
+  // 키는 생성 후 바뀌지 않고, 읽기 스레드가 보는 필드는 atomic으로 저장
+  struct Node {
+    explicit Node(const T &value)
+        : key(value), child{nullptr, nullptr}, height(1), rank(1), pending(0),
+          version(0), size_version(0), locked(false) {}
+
+    const T key;
+    std::atomic<Node *> child[2]; // child[0] : 왼쪽, child[1] : 오른쪽
+    std::atomic<int> height;
+    std::atomic<int> rank;               // 서브트리의 노드 개수
+    std::atomic<int> pending;            // 이 노드를 지나간 뒤 아직 끝나지 않은 삽입/삭제 수
+    std::atomic<uint64_t> version;       // 자식이나 높이를 바꾸는 동안 홀수
+    std::atomic<uint64_t> size_version;  // rank, pending을 바꾸기 전마다 1 증가
+    mutable std::atomic<bool> locked;    // 쓰기 스레드 사이의 노드 잠금
+  };
+
+  // 루트까지의 탐색 결과
+  struct Position {
+    bool found = false;
+    int depth = 0;        // 찾은 노드의 깊이
+    int height = 0;       // 찾은 노드의 높이
+    int ancestor_sum = 0; // 지나온 조상 노드 키 값의 합
+    int rank = 0;         // 찾은 노드의 랭크 (kRank일 때만 계산)
+  };
+
+  // 낙관적 읽기에서 읽은 노드의 버전 (끝난 뒤 그대로인지 확인)
+  struct ReadSet {
+    static constexpr int kCapacity = 2 * (kMaxHeight + 1);
+    const Node *nodes[kCapacity];
+    uint64_t versions[kCapacity];
+    const Node *settled[kCapacity];
+    uint64_t size_versions[kCapacity];
+    int node_count = 0;
+    int settled_count = 0;
+
+    // 쓰기 중인 노드이면 실패
+    bool Add(const Node *node) {
+      uint64_t version = node->version.load(std::memory_order_acquire);
+      if (version & 1)
+        return false;
+      nodes[node_count] = node;
+      versions[node_count++] = version;
+      return true;
+    }
+    // 진행 중인 삽입/삭제가 있어 크기나 높이가 아직 확정되지 않은 노드이면 실패
+    bool Settle(const Node *node) {
+      uint64_t version = node->size_version.load(std::memory_order_acquire);
+      if (node->pending.load(std::memory_order_relaxed) != 0)
+        return false;
+      settled[settled_count] = node;
+      size_versions[settled_count++] = version;
+      return true;
+    }
+    // 서브트리 크기, 확정되지 않았으면 -1
+    int Size(const Node *node) {
+      if (!node)
+        return 0;
+      return Settle(node) ? RankOf(node) : -1;
+    }
+    bool Validate() const {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      for (int i = 0; i < node_count; i++)
+        if (nodes[i]->version.load(std::memory_order_relaxed) != versions[i])
+          return false;
+      for (int i = 0; i < settled_count; i++)
+        if (settled[i]->size_version.load(std::memory_order_relaxed) !=
+            size_versions[i])
+          return false;
+      return true;
+    }
+  };
+
+  // 노드 잠금을 부모에서 자식 순서로 하나씩 옮겨 잡으며 읽는 경로 (낙관적 읽기가 계속 실패할 때 사용)
+  // 잠금을 잡은 노드는 진행 중인 삽입/삭제가 끝나기를 기다리며, 위쪽 잠금은 놓으므로 끝난 뒤 버전을 확인
+  class LockedPath {
+  public:
+    LockedPath() : last_(nullptr) {}
+    ~LockedPath() {
+      if (last_)
+        Unlock(last_);
+    }
+    LockedPath(const LockedPath &) = delete;
+    LockedPath &operator=(const LockedPath &) = delete;
+
+    bool Add(const Node *node) {
+      Lock(node);
+      if (last_)
+        Unlock(last_);
+      last_ = node;
+      return read_set_.Add(node);
+    }
+    // 마지막으로 Add()한 노드만 사용 (잠금을 가진 노드 아래의 쓰기는 잠금 없이 끝남)
+    bool Settle(const Node *node) {
+      while (!read_set_.Settle(node))
+        std::this_thread::yield();
+      return true;
+    }
+    int Size(const Node *node) {
+      if (!node)
+        return 0;
+      Lock(node);
+      Settle(node);
+      int size = RankOf(node);
+      Unlock(node);
+      return size;
+    }
+    bool Validate() const { return read_set_.Validate(); }
+
+  private:
+    const Node *last_;
+    ReadSet read_set_;
+  };
+
+  /**
+   * 기능 : 읽기 함수
+   * 동작 : query를 잠금 없이 실행한 뒤 읽은 노드가 그대로이면 결과를 반환하고, 바뀌었으면 다시 실행
+   *        (계속 실패하면 LockedPath로 실행하고, 그래도 바뀌었으면 다시 실행)
+   * 입력값 : query - (경로, 머리 노드, 결과) -> 성공 여부, 노드를 읽기 전에 경로의 Add()를, 크기나 높이를
+   *          읽기 전에 Settle() 또는 Size()를 호출하고, 중간 상태를 보고 경로가 kMaxHeight를 넘으면 실패를 반환해야 함
+   * 결과값 : query가 채운 결과
+   */
+  template <typename Result, typename Query> Result Read(Query query) const {
+    Result result{};
+    EpochGuard guard(epoch_);
+    for (int attempt = 0; attempt < kMaxOptimisticRetries; attempt++) {
+      ReadSet read_set;
+      if (read_set.Add(&head_) && query(read_set, &head_, result) &&
+          read_set.Validate())
+        return result;
+      std::this_thread::yield();
+    }
+    while (true) {
+      LockedPath path;
+      path.Add(&head_);
+      if (query(path, &head_, result) && path.Validate())
+        return result;
+    }
+  }
+
+  template <bool kRank, typename Access>
+  static bool Descend(const Node *head, T key, Access &access, Position &pos);
+  // 왼쪽 서브트리 크기 + 1을 랭크에 더함 (크기가 확정되지 않았으면 false)
+  template <typename Access>
+  static bool AddLeftSize(const Node *node, Access &access, Position &pos) {
+    int size = access.Size(Child(node, 0));
+    if (size < 0)
+      return false;
+    pos.rank += size + 1;
+    return true;
+  }
+  template <bool kRank> Position Search(T key) const {
+    return Read<Position>(
+        [&key](auto &access, const Node *head, Position &pos) {
+          return Descend<kRank>(head, key, access, pos);
+        });
+  }
+
+  static Node *Child(const Node *node, int dir) {
+    return node->child[dir].load(std::memory_order_acquire);
+  }
+  static int HeightOf(const Node *node) {
+    return node ? node->height.load(std::memory_order_relaxed) : 0;
+  }
+  static int RankOf(const Node *node) {
+    return node ? node->rank.load(std::memory_order_relaxed) : 0;
+  }
+  static int GetBalanceFactor(const Node *node) {
+    return node ? HeightOf(Child(node, 0)) - HeightOf(Child(node, 1)) : 0;
+  }
+
+  // 자식의 높이와 랭크를 기반으로 노드의 높이와 랭크를 갱신
+  static void NodeUpdate(Node *node) {
+    Node *left = Child(node, 0);
+    Node *right = Child(node, 1);
+    node->height.store(1 + std::max(HeightOf(left), HeightOf(right)),
+                       std::memory_order_relaxed);
+    SetRank(node, 1 + RankOf(left) + RankOf(right));
+  }
+  static void SetChild(Node *node, int dir, Node *child) {
+    node->child[dir].store(child, std::memory_order_release);
+  }
+
+  // 노드 잠금 : 부모의 잠금을 가진 채로만 자식의 잠금을 잡으므로 교착 상태가 생기지 않음
+  static void Lock(const Node *node) {
+    while (node->locked.exchange(true, std::memory_order_acquire))
+      std::this_thread::yield();
+  }
+  static void Unlock(const Node *node) {
+    node->locked.store(false, std::memory_order_release);
+  }
+  // path[top, new_top) 구간의 잠금을 해제하고 top을 new_top으로 옮김
+  static void Release(Node *const *path, int &top, int new_top) {
+    for (; top < new_top; top++)
+      Unlock(path[top]);
+  }
+
+  // 쓰기 구간 시작/끝 : 노드의 버전이 홀수인 동안 그 노드를 읽은 스레드는 결과를 버리고 다시 읽음
+  // (잠금을 가진 스레드만 호출)
+  static void BeginWrite(Node *node) {
+    node->version.store(node->version.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  static void EndWrite(Node *node) {
+    node->version.store(node->version.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+  }
+
+  // rank, pending을 바꾸기 전에 호출 : 그 전에 크기를 읽은 스레드는 결과를 버리고 다시 읽음
+  // (Publish()는 잠금 없이 호출하므로 원자적으로 증가)
+  static void BeginSizeWrite(Node *node) {
+    node->size_version.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  static void SetRank(Node *node, int rank) {
+    BeginSizeWrite(node);
+    node->rank.store(rank, std::memory_order_relaxed);
+  }
+  // 내려가는 중에 크기를 delta만큼 바꾸고, 연결/분리가 끝날 때까지 진행 중으로 표시 (잠금을 가진 스레드만 호출)
+  static void Reserve(Node *node, int delta) {
+    BeginSizeWrite(node);
+    node->pending.fetch_add(1, std::memory_order_relaxed);
+    node->rank.fetch_add(delta, std::memory_order_relaxed);
+  }
+  // 연결/분리와 높이 갱신이 끝난 뒤 Reserve()의 표시를 해제 (노드가 이미 트리에서 빠졌어도 됨)
+  static void Publish(Node *node) {
+    BeginSizeWrite(node);
+    node->pending.fetch_sub(1, std::memory_order_release);
+  }
+  // node 아래에서 진행 중인 다른 스레드의 삽입/삭제가 끝나기를 기다림 (own : 자신이 node에 Reserve()한 횟수)
+  // node를 잠근 동안에는 새 쓰기가 들어오지 않고, 진행 중인 쓰기는 node보다 아래의 잠금만 잡으므로 반드시 끝남
+  static void WaitForWriters(const Node *node, int own) {
+    while (node->pending.load(std::memory_order_acquire) > own)
+      std::this_thread::yield();
+  }
+  // 자식의 높이가 바뀌었으면 노드의 높이를 갱신하고 갱신된 높이를 반환
+  static int UpdateHeight(Node *node) {
+    int height =
+        1 + std::max(HeightOf(Child(node, 0)), HeightOf(Child(node, 1)));
+    if (height != HeightOf(node)) {
+      BeginWrite(node);
+      node->height.store(height, std::memory_order_relaxed);
+      EndWrite(node);
+    }
+    return height;
+  }
+
+  std::mutex &KeyMutex(const T &key) {
+    return key_mutexes_[std::hash<T>()(key) % kKeyStripes];
+  }
+
+  static void ReplaceChild(Node *parent, Node *old_node, Node *new_node);
+  static Node *Rotate(Node *parent, Node *node, int dir, int own);
+  static Node *ReBalanceTree(Node *parent, Node *node, bool lock_heavy);
+  static void DeleteTree(Node *node);
+
+  Node head_;                        // child[0]이 루트를 가리키는 머리 노드 (키는 사용하지 않음)
+  std::atomic<int> size_;            // 트리의 노드 개수
+  std::mutex key_mutexes_[kKeyStripes]; // 같은 키를 쓰는 스레드 사이의 잠금
+  std::mutex retire_mutex_;          // epoch_.Retire() 호출 사이의 잠금
+  mutable EpochManager epoch_;       // 삭제된 노드의 회수
+};
+
+/**
+ * 기능 : 루트부터 key를 찾아 내려가는 함수
+ * 동작 : 노드를 읽기 전에 access.Add()로 경로에 기록하고, 깊이, 조상 키의 합, (kRank이면) 랭크를 누적
+ *        (찾은 노드의 높이와 더한 서브트리 크기는 진행 중인 삽입/삭제가 없을 때만 사용)
+ * 입력값 : head - 머리 노드, key - 찾고자 하는 키 값, access - ReadSet 또는 LockedPath, pos - 결과
+ * 결과값 : 중간 상태를 보고 경로를 끝까지 읽지 못했으면 false
+ */
+template <typename T>
+template <bool kRank, typename Access>
+bool ConcurrentAvlTree<T>::Descend(const Node *head, T key, Access &access,
+                                   Position &pos) {
+  pos = Position();
+  const Node *node = Child(head, 0);
+  for (int depth = 0; node; depth++) {
+    if (depth == kMaxHeight || !access.Add(node))
+      return false;
+    if (key == node->key) {
+      if (!access.Settle(node))
+        return false;
+      pos.found = true;
+      pos.depth = depth;
+      pos.height = HeightOf(node);
+      return !kRank || AddLeftSize(node, access, pos);
+    }
+    pos.ancestor_sum += node->key;
+    if (key < node->key) {
+      node = Child(node, 0);
+    } else {
+      if (kRank && !AddLeftSize(node, access, pos))
+        return false;
+      node = Child(node, 1);
+    }
+  }
+  return true;
+}
+
+/**
+ * 기능 : 특정 키 값을 가진 노드의 깊이와 높이의 합을 계산
+ * 동작 : 잠금 없이 루트부터 내려가며 탐색하고, 지나온 노드가 바뀌었으면 다시 탐색
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 키 존재 여부, 깊이 + 높이 }, 노드가 없는 경우 { false, 0 }
+ */
+template <typename T>
+std::pair<bool, int> ConcurrentAvlTree<T>::Find(T key) const {
+  Position pos = Search<false>(key);
+  if (!pos.found)
+    return {false, 0};
+  return {true, pos.depth + pos.height};
+}
+
+/**
+ * 기능 : 특정 노드의 깊이와 높이의 합과 조상 노드 키 값의 합 계산
+ * 동작 : 부모 포인터 대신 루트부터 내려가면서 지나온 노드의 키 값을 합산
+ * 입력값 : key - 찾고자 하는 노드의 키 값
+ * 결과값 : { 깊이+높이, 루트까지 조상 노드 키 값의 합 }, 노드가 없는 경우 { 0, 0 }
+ */
+template <typename T>
+std::pair<int, int> ConcurrentAvlTree<T>::Ancestor(T key) const {
+  Position pos = Search<false>(key);
+  if (!pos.found)
+    return {0, 0};
+  return {pos.depth + pos.height, pos.ancestor_sum};
+}
+
+/**
+ * 기능 : 특정 키 값을 가진 노드의 깊이와 높이의 합, 랭크를 계산
+ * 동작 : 잠금 없이 루트부터 내려가며 오른쪽으로 이동할 때마다 왼쪽 서브트리 크기 + 1을 누적
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 깊이 + 높이, 랭크 }, 노드가 없는 경우 { 0, 0 }
+ */
+template <typename T>
+std::pair<int, int> ConcurrentAvlTree<T>::Rank(T key) const {
+  Position pos = Search<true>(key);
+  if (!pos.found)
+    return {0, 0};
+  return {pos.depth + pos.height, pos.rank};
+}
+
+/**
+ * 기능 : AVL Tree Node 삽입 함수
+ * 동작 : 노드 잠금을 부모에서 자식 순서로 잡으며 내려가 랭크를 1씩 늘리고(Reserve), 균형 인수가 0이 아닌
+ *        노드를 만나면 그 부모보다 위쪽의 잠금을 해제 (높이 변화와 회전은 그 노드에서 멈춤).
+ *        노드를 연결하고 균형을 맞춘 뒤 지나온 노드의 표시를 해제(Publish)하여 새 크기를 읽기 스레드에 공개
+ * 입력값 : key - 삽입할 키 값
+ * 결과값 : 삽입된 노드 또는 이미 있던 같은 키의 노드의 깊이와 높이의 합 (그 노드가 루트이면 0)
+ */
+template <typename T> int ConcurrentAvlTree<T>::Insert(T key) {
+  std::lock_guard<std::mutex> key_lock(KeyMutex(key));
+  // 잠금을 놓은 위쪽 노드가 다른 스레드에서 삭제되어도 Publish()할 때까지 해제되지 않음
+  EpochGuard guard(epoch_);
+
+  // 1. 같은 키를 쓰는 스레드는 없으므로, 잠금 없이 확인한 존재 여부는 끝까지 유지됨
+  Position found = Search<false>(key);
+  if (found.found)
+    return found.depth == 0 ? 0 : found.depth + found.height;
+
+  // 2. 삽입 위치까지 잠금을 옮겨 잡으며 하강 (path[0]은 머리 노드)
+  Node *path[kMaxHeight + 1];
+  int count = 0;
+  int top = 0; // 잠금을 가진 가장 위 노드의 위치
+  int dir = 0;
+  Lock(&head_);
+  path[count++] = &head_;
+  for (Node *node = Child(&head_, 0); node; node = Child(node, dir)) {
+    Lock(node);
+    path[count++] = node;
+    Reserve(node, 1);
+    dir = key < node->key ? 0 : 1;
+    if (GetBalanceFactor(node) != 0)
+      Release(path, top, count - 2);
+  }
+
+  // 3. 새 노드를 부모에 연결
+  Node *new_node = new Node(key);
+  Node *parent = path[count - 1];
+  BeginWrite(parent);
+  SetChild(parent, dir, new_node);
+  EndWrite(parent);
+
+  // 4. 경로를 거슬러 올라가며 높이가 변하는 동안만 균형 조정 (잠금을 가진 구간 안에서 멈춤)
+  int new_depth = count - 1;
+  for (int i = count - 1; i > top; i--) {
+    Node *cur = path[i];
+    int old_height = HeightOf(cur);
+    int balance = GetBalanceFactor(cur);
+    if (balance > 1 || balance < -1) {
+      // 삽입 시 회전은 최대 한 번이며, 무거운 쪽 자식과 손자는 삽입 경로 위에 있어 이미 잠겨 있음
+      Node *sub_root = ReBalanceTree(path[i - 1], cur, false);
+      new_depth = i - 1;
+      for (Node *n = sub_root; n != new_node; n = Child(n, key < n->key ? 0 : 1))
+        new_depth++;
+      break;
+    }
+    if (UpdateHeight(cur) == old_height)
+      break;
+  }
+  int sum = new_depth + HeightOf(new_node);
+
+  // 5. 깊은 노드부터 표시를 해제하여 랭크와 높이를 공개
+  for (int i = count - 1; i > 0; i--)
+    Publish(path[i]);
+  Release(path, top, count);
+  size_.fetch_add(1, std::memory_order_relaxed);
+  return sum;
+}
+
+/**
+ * 기능 : AVL Tree Node 삭제 함수
+ * 동작 : 노드 잠금을 부모에서 자식 순서로 잡으며 내려가 랭크를 1씩 줄이고(Reserve), 균형 인수가 0인 노드를
+ *        만나면 그 위쪽의 잠금을 해제 (한쪽이 낮아져도 높이가 그대로이므로). 노드를 떼어내고 균형을 맞춘 뒤
+ *        지나온 노드의 표시를 해제(Publish)하고, 떼어낸 노드는 에포크 회수로 넘김
+ * 입력값 : key - 삭제할 키 값
+ * 결과값 : 삭제된 노드의 깊이와 높이의 합, 노드가 없는 경우 0
+ */
+template <typename T> int ConcurrentAvlTree<T>::Erase(T key) {
+  std::lock_guard<std::mutex> key_lock(KeyMutex(key));
+  // 잠금을 놓은 위쪽 노드가 다른 스레드에서 삭제되어도 Publish()할 때까지 해제되지 않음
+  EpochGuard guard(epoch_);
+
+  // 1. 같은 키를 쓰는 스레드는 없으므로, 잠금 없이 확인한 존재 여부는 끝까지 유지됨
+  if (!Search<false>(key).found)
+    return 0;
+
+  // 2. 삭제할 노드(자식이 둘이면 후임자 노드)까지 잠금을 옮겨 잡으며 하강 (path[0]은 머리 노드)
+  Node *path[kMaxHeight + 1];
+  int count = 0;
+  int top = 0;    // 잠금을 가진 가장 위 노드의 위치
+  int target = 0; // 삭제할 노드의 위치 (0이면 아직 찾지 못함)
+  Lock(&head_);
+  path[count++] = &head_;
+  for (Node *node = Child(&head_, 0); node;) {
+    Lock(node);
+    path[count++] = node;
+    Reserve(node, -1);
+    Node *next;
+    if (target) {
+      next = Child(node, 0);
+    } else if (key < node->key) {
+      next = Child(node, 0);
+    } else if (key > node->key) {
+      next = Child(node, 1);
+    } else {
+      target = count - 1;
+      next = Child(node, 0) && Child(node, 1) ? Child(node, 1) : nullptr;
+    }
+    // 자리에서 빠지는 마지막 노드는 제외하고, 삭제할 노드의 부모는 자식이 바뀌므로 잠금 유지
+    if (next && GetBalanceFactor(node) == 0)
+      Release(path, top, target ? std::min(count - 1, target - 1) : count - 1);
+    node = next;
+  }
+
+  // 3. 삭제할 노드를 떼어내고 자식이 둘이면 후임자 노드를 그 자리로 옮김
+  Node *reserved[kMaxHeight + 1]; // Reserve()한 노드 (path는 후임자 이동으로 바뀜)
+  int reserved_count = count;
+  std::copy(path, path + count, reserved);
+  Node *node = path[target];
+  int sum = target - 1 + HeightOf(node);
+  Node *left = Child(node, 0);
+  Node *right = Child(node, 1);
+  if (path[count - 1] == node) {
+    // 3.1 자식이 하나 이하인 경우, 자식이 삭제할 노드의 자리를 대신함
+    ReplaceChild(path[target - 1], node, left ? left : right);
+  } else {
+    // 3.2 자식이 둘인 경우, 후임자 노드를 떼어내 삭제할 노드의 자리로 옮김
+    // (후임자가 삭제할 노드의 서브트리 전체를 넘겨받으므로 그 안의 다른 쓰기가 끝나기를 기다림)
+    WaitForWriters(node, 1);
+    Node *successor = path[count - 1];
+    BeginWrite(successor);
+    if (successor != right) {
+      Node *successor_parent = path[count - 2];
+      BeginWrite(successor_parent);
+      SetChild(successor_parent, 0, Child(successor, 1));
+      EndWrite(successor_parent);
+      SetChild(successor, 1, right);
+    }
+    SetChild(successor, 0, left);
+    successor->height.store(HeightOf(node), std::memory_order_relaxed);
+    SetRank(successor, RankOf(node));
+    EndWrite(successor);
+    ReplaceChild(path[target - 1], node, successor);
+    path[target] = successor;
+  }
+  // 떼어낸 노드를 읽던 스레드가 다시 읽도록 버전을 올리고, 경로에서 뺌
+  BeginWrite(node);
+  EndWrite(node);
+  count--;
+
+  // 4. 경로를 거슬러 올라가며 높이가 변하는 동안만 균형 조정 (잠금을 가진 구간 안에서 멈춤)
+  for (int i = count - 1; i > 0 && i >= top; i--) {
+    Node *cur = path[i];
+    int old_height = HeightOf(cur);
+    int balance = GetBalanceFactor(cur);
+    if (balance > 1 || balance < -1)
+      cur = ReBalanceTree(path[i - 1], cur, true);
+    else
+      UpdateHeight(cur);
+    if (HeightOf(cur) == old_height)
+      break;
+  }
+  for (int i = reserved_count - 1; i > 0; i--)
+    Publish(reserved[i]);
+  Release(path, top, count);
+  Unlock(node);
+
+  // 5. 아직 읽고 있는 스레드가 있을 수 있으므로 바로 해제하지 않음
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(retire_mutex_);
+  epoch_.Retire(node);
+  return sum;
+}
+
+/**
+ * 기능 : 부모가 가리키는 자식 노드를 교체하는 함수
+ * 동작 : parent에서 old_node를 가리키던 쪽이 new_node를 가리키도록 함 (parent는 잠겨 있어야 함)
+ * 입력값 : parent - old_node의 부모 (루트이면 머리 노드), old_node - 교체될 노드,
+ *          new_node - 새로 연결할 노드 (nullptr 가능)
+ * 결과값 : 없음
+ */
+template <typename T>
+void ConcurrentAvlTree<T>::ReplaceChild(Node *parent, Node *old_node,
+                                        Node *new_node) {
+  BeginWrite(parent);
+  SetChild(parent, Child(parent, 0) == old_node ? 0 : 1, new_node);
+  EndWrite(parent);
+}
+
+/**
+ * 기능 : 회전 수행 함수
+ * 동작 : dir이 0이면 왼쪽 회전(오른쪽 자식이 올라감), 1이면 오른쪽 회전(왼쪽 자식이 올라감) 수행
+ *        (읽기 스레드가 순환을 만나지 않도록 아래쪽 연결부터 바꿈)
+ * 입력값 : parent - node의 부모, node - 회전할 노드, dir - 회전 방향 (parent, node, 올라갈 자식은 잠겨 있어야 함),
+ *          own - 자신이 node에 Reserve()한 횟수
+ * 결과값 : 회전 후 서브트리의 새로운 루트 노드
+ */
+template <typename T>
+typename ConcurrentAvlTree<T>::Node *
+ConcurrentAvlTree<T>::Rotate(Node *parent, Node *node, int dir, int own) {
+  Node *new_root = Child(node, 1 - dir);
+  Node *moved = Child(new_root, dir);
+  // 올라갈 자식이 node의 나머지 서브트리를 넘겨받으므로, 그 안에서 진행 중인 쓰기가 끝나기를 기다림
+  WaitForWriters(node, own);
+
+  BeginWrite(node);
+  BeginWrite(new_root);
+  SetChild(node, 1 - dir, moved);
+  ReplaceChild(parent, node, new_root);
+  SetChild(new_root, dir, node);
+
+  // 높이 및 랭크 업데이트
+  NodeUpdate(node);
+  NodeUpdate(new_root);
+  EndWrite(new_root);
+  EndWrite(node);
+  return new_root;
+}
+
+/**
+ * 기능 : 트리의 균형을 맞추기 위한 함수
+ * 동작 : 균형 인수를 계산 후, 조건에 따른 회전 수행 (AvlTree와 같은 규칙)
+ * 입력값 : parent - node의 부모, node - 균형 조정을 수행할 노드 (자신의 경로 위에 있어야 함),
+ *          lock_heavy - 회전으로 올라갈 무거운 쪽 자식과 손자를 잠가야 하는지 여부
+ *          (삭제 시에는 삭제 경로의 반대쪽이므로 아직 잠겨 있지 않고 Reserve()하지도 않았음)
+ * 결과값 : 균형 조정된 서브트리의 새로운 루트 노드
+ */
+template <typename T>
+typename ConcurrentAvlTree<T>::Node *
+ConcurrentAvlTree<T>::ReBalanceTree(Node *parent, Node *node,
+                                    bool lock_heavy) {
+  int balance = GetBalanceFactor(node);
+  if (balance >= -1 && balance <= 1)
+    return node;
+
+  // heavy가 0이면 왼쪽, 1이면 오른쪽 서브트리가 무거움
+  int heavy = balance > 1 ? 0 : 1;
+  Node *child = Child(node, heavy);
+  if (lock_heavy)
+    Lock(child);
+  Node *inner = nullptr;
+  int child_balance = GetBalanceFactor(child);
+  if (heavy == 0 ? child_balance < 0 : child_balance > 0) {
+    // LR, RL 회전: 무거운 쪽 자식의 안쪽 자식이 무거운 경우
+    inner = Child(child, 1 - heavy);
+    if (lock_heavy)
+      Lock(inner);
+    Rotate(node, child, heavy, lock_heavy ? 0 : 1);
+  }
+  Node *new_root = Rotate(parent, node, 1 - heavy, 1);
+  if (lock_heavy) {
+    if (inner)
+      Unlock(inner);
+    Unlock(child);
+  }
+  return new_root;
+}
+
+// 서브트리의 모든 노드 해제 (소멸자에서만 사용)
+template <typename T> void ConcurrentAvlTree<T>::DeleteTree(Node *node) {
+  if (node) {
+    DeleteTree(Child(node, 0));
+    DeleteTree(Child(node, 1));
+    delete node;
+  }
+}
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef DRIVER_H_
+#define DRIVER_H_
+
+#include "avl_tree.h"
+#include "command_io.h"
+#include "parallel_for.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// main.cc의 텍스트 명령어 수행부 (테스트에서도 같은 경로로 수행하기 위해 분리)
+
+// 명령어 하나의 결과 (출력할 정수 count개)
+struct CommandResult {
+  int count;
+  int values[2];
+};
+
+// 미리 읽어 둔 명령어 하나 (kUnknown이면 x는 unknown_words의 번호)
+struct CommandRecord {
+  Command command;
+  int x;
+};
+
+// 미리 읽어 둔 테스트 케이스
+struct TestCase {
+  std::vector<CommandRecord> commands;
+  std::vector<std::string> unknown_words; // 알 수 없는 명령어 토큰
+};
+
+// 결과 정수들을 공백으로 구분해 한 줄로 씀
+inline void WriteResult(OutputBuffer &out, const CommandResult &result) {
+  for (int j = 0; j < result.count; j++) {
+    if (j > 0)
+      out.WriteChar(' ');
+    out.WriteInt(result.values[j]);
+  }
+  out.WriteChar('\n');
+}
+
+// 알 수 없는 명령어 메시지를 씀 (UserTest와 같은 문구)
+inline void WriteUnknown(OutputBuffer &out, std::string_view word) {
+  out.Write("올바르지 않은 명령어입니다: ");
+  out.Write(word);
+  out.WriteChar('\n');
+}
+
+/**
+ * 기능 : 명령어 하나를 트리에 수행하는 함수
+ * 동작 : 명령어 종류에 따라 트리 함수를 호출하고 UserTest가 출력하는 정수들을 모음
+ * 입력값 : avltree - 대상 트리, command - 명령어 종류 (kUnknown 제외), x - 정수 인자
+ * 결과값 : 출력할 정수들
+ */
+inline CommandResult RunCommand(AvlTree<int> &avltree, Command command, int x) {
+  switch (command) {
+  case Command::kInsert:
+    return {1, {avltree.Insert(x)}};
+  case Command::kEmpty:
+    return {1, {avltree.Empty()}};
+  case Command::kFind:
+    return {1, {avltree.Find(x).second}};
+  case Command::kSize:
+    return {1, {avltree.Size()}};
+  case Command::kRank: {
+    std::pair<int, int> result = avltree.Rank(x);
+    if (result.first == 0)
+      return {1, {0}};
+    return {2, {result.first, result.second}};
+  }
+  case Command::kErase:
+    return {1, {avltree.Erase(x)}};
+  case Command::kHeight:
+    return {1, {avltree.Height()}};
+  case Command::kAncestor: {
+    std::pair<int, int> result = avltree.Ancestor(x);
+    return {2, {result.first, result.second}};
+  }
+  case Command::kAverage:
+    return {1, {avltree.Average(x)}};
+  default:
+    return {0, {}};
+  }
+}
+
+/**
+ * 기능 : 테스트 케이스 하나를 빠른 입출력으로 수행하는 함수
+ * 동작 : 명령어 토큰을 ParseCommand로 분기하고, 정수는 iostream 없이 읽으며, 결과는 out에 모음
+ * 입력값 : in - 입력 버퍼, out - 출력 버퍼
+ * 결과값 : 없음 (출력 형식은 UserTest와 같음)
+ */
+inline void FastUserTest(InputBuffer &in, OutputBuffer &out) {
+  AvlTree<int> avltree;
+  int Q = 0;
+  in.ReadInt(Q);
+
+  std::string_view word;
+  for (int i = 0; i < Q && in.ReadWord(word); i++) {
+    Command command = ParseCommand(word);
+    if (command == Command::kUnknown) {
+      WriteUnknown(out, word);
+      continue;
+    }
+
+    int x = 0;
+    if (HasOperand(command))
+      in.ReadInt(x);
+    WriteResult(out, RunCommand(avltree, command, x));
+  }
+}
+
+/**
+ * 기능 : 테스트 케이스 하나를 수행하지 않고 읽기만 하는 함수
+ * 동작 : Q와 명령어 Q개를 FastUserTest와 같은 규칙으로 읽어 test_case에 저장
+ * 입력값 : in - 텍스트 명령어 입력, test_case - 명령어를 받을 케이스
+ * 결과값 : 없음
+ */
+inline void ReadTestCase(InputBuffer &in, TestCase &test_case) {
+  int Q = 0;
+  in.ReadInt(Q);
+  test_case.commands.reserve(std::max(Q, 0));
+
+  std::string_view word;
+  for (int i = 0; i < Q && in.ReadWord(word); i++) {
+    Command command = ParseCommand(word);
+    int x = 0;
+    if (command == Command::kUnknown) {
+      x = static_cast<int>(test_case.unknown_words.size());
+      test_case.unknown_words.emplace_back(word);
+    } else if (HasOperand(command)) {
+      in.ReadInt(x);
+    }
+    test_case.commands.push_back({command, x});
+  }
+}
+
+// 미리 읽어 둔 테스트 케이스를 새 트리에 수행
+inline void RunTestCase(const TestCase &test_case, OutputBuffer &out) {
+  AvlTree<int> avltree;
+  for (const CommandRecord &record : test_case.commands) {
+    if (record.command == Command::kUnknown)
+      WriteUnknown(out, test_case.unknown_words[record.x]);
+    else
+      WriteResult(out, RunCommand(avltree, record.command, record.x));
+  }
+}
+
+/**
+ * 기능 : 미리 읽어 둔 테스트 케이스들을 여러 스레드로 수행하는 함수
+ * 동작 : 스레드마다 다음 케이스들을 가져가 케이스별 출력 버퍼에 수행한 뒤,
+ *        출력 버퍼를 원래 순서대로 이어 씀 (케이스는 서로 트리를 공유하지 않으며, 수행한 케이스는 비움)
+ * 입력값 : test_cases - 수행할 케이스들, out - 출력 버퍼, thread_count - 스레드 수 (0이면 하드웨어 스레드 수)
+ * 결과값 : 없음 (출력은 케이스마다 RunTestCase를 차례로 수행한 것과 바이트 단위로 같음)
+ */
+inline void RunTestCases(std::vector<TestCase> &test_cases, OutputBuffer &out,
+                         unsigned thread_count = 0) {
+  std::vector<OutputBuffer> outputs(test_cases.size());
+  ParallelFor(
+      test_cases.size(),
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          RunTestCase(test_cases[i], outputs[i]);
+          test_cases[i] = TestCase();
+        }
+      },
+      thread_count, 1);
+
+  for (const OutputBuffer &output : outputs)
+    out.Write(output.View());
+}
+
+#endif // DRIVER_H_
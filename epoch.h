@@ -0,0 +1,172 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef EPOCH_H_
+#define EPOCH_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * 에포크 기반 메모리 회수 클래스
+ * 기능 : 잠금 없이 읽는 스레드가 아직 보고 있을 수 있는 노드의 해제를 미룸
+ * 설명 :
+ * - 읽기 스레드는 Pin()으로 현재 에포크를 슬롯에 알리고, 끝나면 Unpin()으로 슬롯을 비움
+ * - 트리에서 떼어낸 노드는 Retire()로 떼어낸 시점의 에포크와 함께 보관
+ * - 전역 에포크는 고정된 모든 스레드가 현재 에포크를 알렸을 때만 1 증가하므로,
+ *   보관 후 에포크가 2 증가했다면 그 노드를 볼 수 있는 읽기 스레드는 없음
+ * - Retire()와 Collect()는 한 번에 한 스레드만 호출 (여러 쓰기 스레드가 있으면 호출하는 쪽에서 잠금으로 보호)
+ */
+class EpochManager {
+public:
+  // 동시에 고정할 수 있는 최대 스레드 수
+  static constexpr size_t kMaxSlots = 128;
+  // 보관된 노드가 이 개수 이상이면 Retire()가 회수를 시도
+  static constexpr size_t kCollectThreshold = 64;
+
+  EpochManager() : global_epoch_(1) {
+    for (Slot &slot : slots_)
+      slot.epoch.store(0, std::memory_order_relaxed);
+  }
+  EpochManager(const EpochManager &) = delete;
+  EpochManager &operator=(const EpochManager &) = delete;
+  // 고정된 스레드가 없을 때 소멸해야 함
+  ~EpochManager() {
+    for (Retired &retired : retired_)
+      retired.deleter(retired.ptr);
+  }
+
+  /**
+   * 기능 : 현재 스레드를 에포크에 고정하는 함수
+   * 동작 : 빈 슬롯을 찾아 현재 에포크를 기록하고, 그 사이 에포크가 바뀌었으면 다시 기록
+   * 입력값 : 없음
+   * 결과값 : Unpin()에 넘길 슬롯 번호
+   */
+  size_t Pin() {
+    size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (size_t i = 0;; i++) {
+      size_t index = (start + i) % kMaxSlots;
+      std::atomic<uint64_t> &slot = slots_[index].epoch;
+      uint64_t epoch = global_epoch_.load();
+      uint64_t expected = 0;
+      if (slot.load(std::memory_order_relaxed) != 0 ||
+          !slot.compare_exchange_strong(expected, epoch))
+        continue;
+      for (uint64_t now; (now = global_epoch_.load()) != epoch;) {
+        epoch = now;
+        slot.store(epoch);
+      }
+      return index;
+    }
+  }
+
+  void Unpin(size_t index) {
+    slots_[index].epoch.store(0, std::memory_order_release);
+  }
+
+  /**
+   * 기능 : 트리에서 떼어낸 노드의 해제를 예약하는 함수
+   * 동작 : 노드와 현재 에포크를 보관하고, 보관된 노드가 많으면 회수를 시도
+   * 입력값 : node - 더 이상 트리에서 도달할 수 없는 노드
+   * 결과값 : 없음
+   */
+  template <typename NodeType> void Retire(NodeType *node) {
+    retired_.push_back(
+        {node, [](void *ptr) { delete static_cast<NodeType *>(ptr); },
+         global_epoch_.load()});
+    if (retired_.size() >= kCollectThreshold)
+      Collect();
+  }
+
+  /**
+   * 기능 : 안전하게 해제할 수 있는 노드를 회수하는 함수
+   * 동작 : 고정된 모든 스레드가 현재 에포크에 있으면 에포크를 올리고, 2 에포크 이전에 보관된 노드를 해제
+   * 입력값 : 없음
+   * 결과값 : 없음
+   */
+  void Collect() {
+    uint64_t epoch = global_epoch_.load();
+    bool can_advance = true;
+    for (Slot &slot : slots_) {
+      uint64_t pinned = slot.epoch.load();
+      if (pinned != 0 && pinned != epoch) {
+        can_advance = false;
+        break;
+      }
+    }
+    if (can_advance)
+      global_epoch_.store(++epoch);
+
+    size_t kept = 0;
+    for (Retired &retired : retired_) {
+      if (retired.epoch + 2 <= epoch)
+        retired.deleter(retired.ptr);
+      else
+        retired_[kept++] = retired;
+    }
+    retired_.resize(kept);
+  }
+
+private:
+  // 슬롯마다 캐시 라인을 따로 사용하여 거짓 공유를 막음
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> epoch; // 고정된 에포크 (0이면 빈 슬롯)
+  };
+
+  struct Retired {
+    void *ptr;
+    void (*deleter)(void *);
+    uint64_t epoch; // 보관된 시점의 에포크
+  };
+
+  std::atomic<uint64_t> global_epoch_; // 전역 에포크
+  Slot slots_[kMaxSlots];              // 스레드별 고정 에포크
+  std::vector<Retired> retired_;       // 해제를 기다리는 노드
+};
+
+/**
+ * 에포크 고정 클래스
+ * 기능 : 생성 시 Pin(), 소멸 시 Unpin()을 호출하는 RAII 도우미
+ */
+class EpochGuard {
+public:
+  explicit EpochGuard(EpochManager &manager)
+      : manager_(manager), slot_(manager.Pin()) {}
+  ~EpochGuard() { manager_.Unpin(slot_); }
+  EpochGuard(const EpochGuard &) = delete;
+  EpochGuard &operator=(const EpochGuard &) = delete;
+
+private:
+  EpochManager &manager_;
+  size_t slot_;
+};
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef FROZEN_SET_H_
+#define FROZEN_SET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * 고정(frozen) 집합 클래스
+ * 기능 : 트리를 수정할 수 없는 Eytzinger(BFS 순서) 배열로 바꾸어 캐시 친화적으로 탐색
+ * 설명 :
+ * - 위치 k(1부터 시작)의 왼쪽 자식은 2k, 오른쪽 자식은 2k + 1이므로 포인터 없이 탐색
+ * - 탐색은 분기 없이 자식 위치를 계산하고, 4단계 아래(16k)의 키 블록을 미리 읽음
+ * - 키 배열과 질의 결과용 배열(깊이 + 높이, 랭크)을 분리하여 탐색 중에는 키 배열만 읽음
+ * - 원래 트리의 깊이 + 높이를 키마다 저장하므로 Find, Rank는 Set과 같은 결과를 반환
+ */
+template <typename T> class FrozenSet {
+public:
+  FrozenSet() : height_(-1) {}
+
+  /**
+   * 기능 : 트리로부터 고정 집합을 만드는 함수
+   * 동작 : 중위 순회로 키와 깊이 + 높이를 모은 뒤, Eytzinger 배열을 중위 순서로 채움 (O(n))
+   * 입력값 : tree - ForEachNode를 제공하는 트리 (Set 계열)
+   * 결과값 : 없음
+   */
+  template <typename Tree> explicit FrozenSet(const Tree &tree) {
+    std::vector<T> sorted;
+    std::vector<int> sums;
+    sorted.reserve(tree.Size());
+    sums.reserve(tree.Size());
+    tree.ForEachNode([&](const auto &node, int depth) {
+      sorted.push_back(node.GetKey());
+      sums.push_back(depth + node.GetHeight());
+    });
+    height_ = tree.Height();
+
+    size_t n = sorted.size();
+    keys_.resize(n + 1);
+    sums_.resize(n + 1);
+    ranks_.resize(n + 1);
+    slots_.resize(n);
+    size_t next = 0;
+    Fill(sorted, sums, 1, next);
+  }
+
+  // 기본 기능
+  bool Empty() const { return slots_.empty(); }
+  int Size() const { return static_cast<int>(slots_.size()); }
+  int Height() const { return height_; }
+
+  // { 키 포인터, 깊이 + 높이 }, 키가 없으면 { nullptr, 0 }
+  std::pair<const T *, int> Find(T key) const {
+    size_t k = LowerBoundSlot(key);
+    if (k == 0 || !(keys_[k] == key))
+      return {nullptr, 0};
+    return {&keys_[k], sums_[k]};
+  }
+
+  // 고급 기능 : { 깊이 + 높이, 랭크 }, 키가 없으면 { 0, 0 }
+  std::pair<int, int> Rank(T key) const {
+    size_t k = LowerBoundSlot(key);
+    if (k == 0 || !(keys_[k] == key))
+      return {0, 0};
+    return {sums_[k], static_cast<int>(ranks_[k])};
+  }
+
+  // key 이상인 첫 키, 없으면 nullptr
+  const T *lower_bound(T key) const {
+    size_t k = LowerBoundSlot(key);
+    return k ? &keys_[k] : nullptr;
+  }
+
+  // key보다 작은 키의 개수
+  int RankOfBound(T key) const {
+    size_t k = LowerBoundSlot(key);
+    return k ? static_cast<int>(ranks_[k]) - 1 : Size();
+  }
+
+  // k번째로 작은 키 (1부터 시작), 범위를 벗어나면 nullptr
+  const T *Select(int k) const {
+    if (k < 1 || k > Size())
+      return nullptr;
+    return &keys_[slots_[k - 1]];
+  }
+
+private:
+  // 중위 순서대로 위치 k의 서브트리를 채움
+  void Fill(const std::vector<T> &sorted, const std::vector<int> &sums,
+            size_t k, size_t &next) {
+    if (k >= keys_.size())
+      return;
+    Fill(sorted, sums, 2 * k, next);
+    keys_[k] = sorted[next];
+    sums_[k] = sums[next];
+    ranks_[k] = static_cast<uint32_t>(next + 1);
+    slots_[next] = static_cast<uint32_t>(k);
+    next++;
+    Fill(sorted, sums, 2 * k + 1, next);
+  }
+
+  /**
+   * 기능 : key 이상인 첫 키의 위치를 찾는 함수
+   * 동작 : 키 비교 결과를 자식 위치 계산에 그대로 더해 분기 없이 내려간 뒤,
+   *        마지막으로 왼쪽으로 내려간 지점(끝의 1 비트들과 그 위 한 비트를 지운 위치)으로 돌아감
+   * 입력값 : key - 기준 키
+   * 결과값 : 위치 (1부터 시작), 없으면 0
+   */
+  size_t LowerBoundSlot(const T &key) const {
+    size_t n = keys_.size();
+    size_t k = 1;
+    while (k < n) {
+      // 16k ~ 16k + 15 위치는 4단계 아래의 후손들로, 한 캐시 라인에 모여 있음
+      if (16 * k < n)
+        Prefetch(&keys_[16 * k]);
+      k = 2 * k + (keys_[k] < key);
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return k >> __builtin_ffsll(static_cast<long long>(~k));
+#else
+    while (k & 1)
+      k >>= 1;
+    return k >> 1;
+#endif
+  }
+
+  static void Prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+  }
+
+  std::vector<T> keys_;         // Eytzinger 순서의 키 (0번은 사용하지 않음)
+  std::vector<int> sums_;       // 원래 트리에서의 깊이 + 높이
+  std::vector<uint32_t> ranks_; // 랭크 (중위 순서, 1부터 시작)
+  std::vector<uint32_t> slots_; // 랭크 - 1 -> 위치
+  int height_;                  // 원래 트리의 높이
+};
+
+#endif
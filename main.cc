@@ -26,93 +26,253 @@ Date : 2024-11-26
 */
 
 #include "avl_tree.h"
+#include "command_io.h"
+#include "driver.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 using namespace std;
 
 void UserTest();
+int ParallelMain(InputBuffer &in, OutputBuffer &out);
+int BinaryMain(InputBuffer &in, OutputBuffer &out);
+bool BinaryUserTest(InputBuffer &in, OutputBuffer &out);
+int EncodeCommands(InputBuffer &in, OutputBuffer &out);
+int DecodeCommands(InputBuffer &in, OutputBuffer &out);
 
-int main() {
-  ios_base::sync_with_stdio(false);
-  cin.tie(nullptr);
-  cout.tie(nullptr);
+/**
+ * 실행 방법 : main [실행 방식] [입력 파일]
+ * - 기본 : iostream으로 stdin을 읽고 쓰는 기존 방식 (입력 파일 인자는 사용하지 않음)
+ * - --fast : 입력 파일(없으면 stdin)을 mmap 또는 큰 블록으로 읽고, 결과를 하나의 버퍼에 모아 출력
+ * - --parallel : 테스트 케이스를 모두 읽은 뒤 여러 스레드로 수행하고, 출력은 기본 방식과 같은 순서로 씀
+ * - --binary : 이진 명령어를 읽고 결과를 이진 정수로 출력 (형식은 command_io.h 참고)
+ * - --encode, --decode : 텍스트 명령어와 이진 명령어 사이의 변환
+ */
+int main(int argc, char **argv) {
+  const char *mode = argc > 1 && strncmp(argv[1], "--", 2) == 0 ? argv[1] : "";
+  int path_index = *mode ? 2 : 1;
+  const char *path = argc > path_index ? argv[path_index] : nullptr;
 
-  int T;
-  std::cin >> T;
-  for (int test_case = 1; test_case <= T; test_case++) {
-    UserTest();
+  if (!*mode) {
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+    cout.tie(nullptr);
+
+    int T;
+    std::cin >> T;
+    for (int test_case = 1; test_case <= T; test_case++) {
+      UserTest();
+    }
+    return 0;
+  }
+
+  InputBuffer in(path);
+  if (!in.IsOpen()) {
+    fprintf(stderr, "입력 파일을 열 수 없습니다: %s\n", path);
+    return 1;
+  }
+  OutputBuffer out(stdout);
+
+  if (strcmp(mode, "--fast") == 0) {
+    int T = 0;
+    in.ReadInt(T);
+    for (int test_case = 1; test_case <= T; test_case++) {
+      FastUserTest(in, out);
+    }
+    return 0;
   }
+  if (strcmp(mode, "--parallel") == 0)
+    return ParallelMain(in, out);
+  if (strcmp(mode, "--binary") == 0)
+    return BinaryMain(in, out);
+  if (strcmp(mode, "--encode") == 0)
+    return EncodeCommands(in, out);
+  if (strcmp(mode, "--decode") == 0)
+    return DecodeCommands(in, out);
+  fprintf(stderr, "알 수 없는 실행 방식입니다: %s\n", mode);
+  return 1;
 }
 
-void UserTest() {
-  AvlTree<int> avltree;
-  int Q;
-  std::cin >> Q;
+/**
+ * 기능 : 테스트 케이스를 여러 스레드로 수행하는 함수
+ * 동작 : 모든 케이스를 ReadTestCase로 먼저 읽은 뒤 RunTestCases로 수행
+ * 입력값 : in - 텍스트 명령어 입력, out - 출력 버퍼
+ * 결과값 : 프로그램 종료 코드 (출력은 기본 방식과 바이트 단위로 같음)
+ */
+int ParallelMain(InputBuffer &in, OutputBuffer &out) {
+  int T = 0;
+  in.ReadInt(T);
+  std::vector<TestCase> test_cases(std::max(T, 0));
+  for (TestCase &test_case : test_cases)
+    ReadTestCase(in, test_case);
 
-  for (int i = 0; i < Q; i++) {
-    string command;
-    std::cin >> command;
+  RunTestCases(test_cases, out);
+  return 0;
+}
 
-    if (command == "Insert") {
-      int x;
-      std::cin >> x;
-      int result = avltree.Insert(x);
-      std::cout << result << "\n";
-    }
+// 이진 입력의 머리(kBinaryMagic, T)를 읽음
+bool ReadBinaryHeader(InputBuffer &in, uint32_t &T) {
+  char magic[sizeof(kBinaryMagic)];
+  if (!in.ReadBytes(magic, sizeof(magic)) ||
+      memcmp(magic, kBinaryMagic, sizeof(magic)) != 0) {
+    fprintf(stderr, "이진 명령어 형식이 아닙니다\n");
+    return false;
+  }
+  return in.ReadUint32(T);
+}
 
-    else if (command == "Empty") {
-      std::cout << avltree.Empty() << "\n";
+/**
+ * 기능 : 이진 명령어 입력 전체를 수행하는 함수
+ * 동작 : 머리를 확인한 뒤 테스트 케이스마다 BinaryUserTest 수행
+ * 입력값 : in - 이진 명령어 입력, out - 이진 결과 출력
+ * 결과값 : 프로그램 종료 코드 (입력 형식이 올바르지 않으면 1)
+ */
+int BinaryMain(InputBuffer &in, OutputBuffer &out) {
+  uint32_t T;
+  if (!ReadBinaryHeader(in, T))
+    return 1;
+  for (uint32_t test_case = 1; test_case <= T; test_case++) {
+    if (!BinaryUserTest(in, out)) {
+      fprintf(stderr, "이진 명령어 입력이 중간에 끝났습니다\n");
+      return 1;
     }
+  }
+  return 0;
+}
 
-    else if (command == "Find") {
-      int x;
-      std::cin >> x;
-      std::pair<Node<int> *, int> result = avltree.Find(x);
-      std::cout << result.second << "\n";
-    }
+/**
+ * 기능 : 이진 명령어로 된 테스트 케이스 하나를 수행하는 함수
+ * 동작 : 5바이트 명령어를 한 번에 읽어 RunCommand로 수행하고, 결과를 ResultWidth개의 정수로 출력
+ * 입력값 : in - 이진 명령어 입력, out - 이진 결과 출력
+ * 결과값 : 케이스를 끝까지 읽었는지 여부
+ */
+bool BinaryUserTest(InputBuffer &in, OutputBuffer &out) {
+  AvlTree<int> avltree;
+  uint32_t Q;
+  if (!in.ReadUint32(Q))
+    return false;
 
-    else if (command == "Size") {
-      std::cout << avltree.Size() << "\n";
-    }
+  unsigned char record[kBinaryCommandSize];
+  for (uint32_t i = 0; i < Q; i++) {
+    if (!in.ReadBytes(record, sizeof(record)))
+      return false;
+    Command command = std::min(static_cast<Command>(record[0]), Command::kUnknown);
+    int x = static_cast<int>(InputBuffer::DecodeUint32(record + 1));
+    if (command == Command::kUnknown)
+      continue;
 
-    else if (command == "Rank") {
-      int x;
-      std::cin >> x;
-      auto result = avltree.Rank(x);
-      if (result.first == 0) {
-        std::cout << "0\n";
-      } else {
-        std::cout << result.first << " " << result.second << "\n";
+    CommandResult result = RunCommand(avltree, command, x);
+    for (int j = 0; j < ResultWidth(command); j++)
+      out.WriteUint32(j < result.count ? result.values[j] : 0);
+  }
+  return true;
+}
+
+/**
+ * 기능 : 텍스트 명령어를 이진 명령어로 바꾸는 함수
+ * 동작 : T, Q와 명령어를 텍스트로 읽어 command_io.h의 이진 형식으로 출력
+ * 입력값 : in - 텍스트 명령어 입력, out - 이진 명령어 출력
+ * 결과값 : 프로그램 종료 코드 (알 수 없는 명령어가 있으면 1)
+ */
+int EncodeCommands(InputBuffer &in, OutputBuffer &out) {
+  int T = 0;
+  in.ReadInt(T);
+  out.Write(std::string_view(kBinaryMagic, sizeof(kBinaryMagic)));
+  out.WriteUint32(T);
+  for (int test_case = 1; test_case <= T; test_case++) {
+    int Q = 0;
+    in.ReadInt(Q);
+    out.WriteUint32(Q);
+
+    std::string_view word;
+    for (int i = 0; i < Q && in.ReadWord(word); i++) {
+      Command command = ParseCommand(word);
+      if (command == Command::kUnknown) {
+        fprintf(stderr, "이진 형식으로 바꿀 수 없는 명령어입니다: %.*s\n",
+                static_cast<int>(word.size()), word.data());
+        return 1;
       }
+      int x = 0;
+      if (HasOperand(command))
+        in.ReadInt(x);
+      out.WriteChar(static_cast<char>(command));
+      out.WriteUint32(x);
     }
+  }
+  return 0;
+}
 
-    else if (command == "Erase") {
-      int x;
-      std::cin >> x;
-      int result = avltree.Erase(x);
-      std::cout << result << "\n";
-    }
+/**
+ * 기능 : 이진 명령어를 텍스트 명령어로 바꾸는 함수
+ * 동작 : 이진 형식을 읽어 T, Q와 명령어를 한 줄에 하나씩 텍스트로 출력 (인자가 없는 명령어는 인자를 생략)
+ * 입력값 : in - 이진 명령어 입력, out - 텍스트 명령어 출력
+ * 결과값 : 프로그램 종료 코드 (입력 형식이 올바르지 않으면 1)
+ */
+int DecodeCommands(InputBuffer &in, OutputBuffer &out) {
+  uint32_t T;
+  if (!ReadBinaryHeader(in, T))
+    return 1;
+  out.WriteInt(T);
+  out.WriteChar('\n');
+  for (uint32_t test_case = 1; test_case <= T; test_case++) {
+    uint32_t Q;
+    if (!in.ReadUint32(Q))
+      return 1;
+    out.WriteInt(Q);
+    out.WriteChar('\n');
 
-    else if (command == "Height") {
-      std::cout << avltree.Height() << "\n";
+    unsigned char record[kBinaryCommandSize];
+    for (uint32_t i = 0; i < Q; i++) {
+      Command command = Command::kUnknown;
+      if (in.ReadBytes(record, sizeof(record)))
+        command = std::min(static_cast<Command>(record[0]), Command::kUnknown);
+      if (command == Command::kUnknown) {
+        fprintf(stderr, "올바르지 않은 이진 명령어입니다\n");
+        return 1;
+      }
+      out.Write(CommandName(command));
+      if (HasOperand(command)) {
+        out.WriteChar(' ');
+        out.WriteInt(static_cast<int>(InputBuffer::DecodeUint32(record + 1)));
+      }
+      out.WriteChar('\n');
     }
+  }
+  return 0;
+}
 
-    else if (command == "Ancestor") {
-      int x;
-      cin >> x;
-      std::pair<int, int> result = avltree.Ancestor(x);
-      std::cout << result.first << ' ' << result.second << "\n";
-    }
+/**
+ * 기능 : 테스트 케이스 하나를 iostream으로 수행하는 함수
+ * 동작 : 명령어 토큰을 ParseCommand로 분기하고 driver.h의 RunCommand로 수행하여 결과를 한 줄씩 출력
+ * 입력값 : 없음 (stdin에서 Q와 명령어 Q개를 읽음)
+ * 결과값 : 없음 (출력 형식은 FastUserTest와 같음)
+ */
+void UserTest() {
+  AvlTree<int> avltree;
+  int Q;
+  std::cin >> Q;
 
-    else if (command == "Average") {
-      int x;
-      cin >> x;
-      cout << avltree.Average(x) << "\n";
+  for (int i = 0; i < Q; i++) {
+    string word;
+    std::cin >> word;
+    Command command = ParseCommand(word);
+    if (command == Command::kUnknown) {
+      cout << "올바르지 않은 명령어입니다: " << word << "\n";
+      continue;
     }
 
-    else {
-      cout << "올바르지 않은 명령어입니다: " << command << "\n";
-    }
+    int x = 0;
+    if (HasOperand(command))
+      std::cin >> x;
+    CommandResult result = RunCommand(avltree, command, x);
+    for (int j = 0; j < result.count; j++)
+      std::cout << (j > 0 ? " " : "") << result.values[j];
+    std::cout << "\n";
   }
-}
\ No newline at end of file
+}
@@ -28,25 +28,57 @@ Date : 2024-11-26
 #ifndef NODE_H_
 #define NODE_H_
 
+#include "augment.h"
+#include <utility>
+
+/**
+ * 노드 집계값 클래스
+ * 기능 : 서브트리 집계값(Augment::Value)을 노드에 저장
+ * 설명 : 집계값이 없는 경우(void) 크기가 0인 빈 클래스로 특수화
+ */
+template <typename T, typename Augment, typename Value = typename Augment::Value>
+class NodeAggregate {
+public:
+  explicit NodeAggregate(const T &key) : aggregate_(Augment::FromKey(key)) {}
+
+  const Value &GetAggregate() const { return aggregate_; }
+  void SetAggregate(const Value &aggregate) { aggregate_ = aggregate; }
+
+private:
+  Value aggregate_; // 서브트리 집계값
+};
+
+template <typename T, typename Augment>
+class NodeAggregate<T, Augment, void> {
+public:
+  explicit NodeAggregate(const T &) {}
+};
+
 /**
  * 노드 클래스
  * 기능 : tree의 요소를 Node 클래스로 정의
- * 설명 : 인자에 따라 node의 정보를 초기화
+ * 설명 : 인자에 따라 node의 정보를 초기화, Augment 정책이 있으면 서브트리 집계값도 저장
  */
-template <typename T> class Node {
+template <typename T, typename Augment = NoAugment>
+class Node : public NodeAggregate<T, Augment> {
 public:
+  using KeyType = T;
+
   // 생성자
   Node();
-  explicit Node(T value);
+  explicit Node(const T &value);
+  explicit Node(T &&value);
 
-  // 소멸자
-  ~Node();
+  // 소멸자 (키와 집계값의 소멸자가 없으면 노드도 소멸자가 없는 타입이 되도록 기본 소멸자 사용)
+  ~Node() = default;
 
   // 접근자 (Getter)
   Node *GetParent() const { return parent_; }
   Node *&GetLeft() { return left_; }
   Node *&GetRight() { return right_; }
-  T GetKey() const { return key_; }
+  Node *GetLeft() const { return left_; }
+  Node *GetRight() const { return right_; }
+  const T &GetKey() const { return key_; }
   int GetHeight() const { return height_; }
   int GetRank() const { return rank_; }
 
@@ -54,7 +86,8 @@ public:
   void SetParent(Node *parent) { parent_ = parent; }
   void SetLeft(Node *left) { left_ = left; }
   void SetRight(Node *right) { right_ = right; }
-  void SetKey(T key) { key_ = key; }
+  void SetKey(const T &key) { key_ = key; }
+  void SetKey(T &&key) { key_ = std::move(key); }
   void SetHeight(int height) { height_ = height; }
   void SetRank(int rank) { rank_ = rank; }
 
@@ -68,18 +101,21 @@ private:
 };
 
 // 기본 생성자
-template <typename T>
-Node<T>::Node()
-    : parent_(nullptr), left_(nullptr), right_(nullptr), key_(T()), height_(1),
-      rank_(1) {}
+template <typename T, typename Augment>
+Node<T, Augment>::Node()
+    : NodeAggregate<T, Augment>(T()), parent_(nullptr), left_(nullptr),
+      right_(nullptr), key_(T()), height_(1), rank_(1) {}
 
 // 키 값으로 초기화하는 생성자
-template <typename T>
-Node<T>::Node(T value)
-    : parent_(nullptr), left_(nullptr), right_(nullptr), key_(value),
-      height_(1), rank_(1) {}
+template <typename T, typename Augment>
+Node<T, Augment>::Node(const T &value)
+    : NodeAggregate<T, Augment>(value), parent_(nullptr), left_(nullptr),
+      right_(nullptr), key_(value), height_(1), rank_(1) {}
 
-// 소멸자
-template <typename T> Node<T>::~Node() {}
+// 키를 옮겨 초기화하는 생성자 (집계값은 옮기기 전에 계산)
+template <typename T, typename Augment>
+Node<T, Augment>::Node(T &&value)
+    : NodeAggregate<T, Augment>(value), parent_(nullptr), left_(nullptr),
+      right_(nullptr), key_(std::move(value)), height_(1), rank_(1) {}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef NODE_ALLOCATOR_H_
+#define NODE_ALLOCATOR_H_
+
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * 기본 노드 할당자 클래스
+ * 기능 : new/delete로 노드를 하나씩 할당하고 해제
+ * 설명 : Set/AvlTree의 기본 할당자 정책으로, 별도의 상태를 갖지 않음
+ */
+template <typename NodeType> class NodeAllocator {
+public:
+  // 트리 전체를 한 번에 해제할 수 있는지 여부
+  static constexpr bool kBulkRelease = false;
+
+  template <typename... Args> NodeType *Allocate(Args &&...args) {
+    return new NodeType(std::forward<Args>(args)...);
+  }
+  void Deallocate(NodeType *node) { delete node; }
+  void Reserve(int) {}
+  void Release() {}
+};
+
+/**
+ * 슬랩 노드 할당자 클래스
+ * 기능 : 큰 연속 블록에서 노드를 잘라 할당하고, 해제된 노드는 free list로 재사용
+ * 설명 : 소멸 시 노드를 하나씩 순회하지 않고 블록 단위로 메모리를 해제
+ */
+template <typename NodeType> class SlabAllocator {
+public:
+  static constexpr bool kBulkRelease = true;
+
+  SlabAllocator()
+      : free_list_(nullptr), cursor_(nullptr), end_(nullptr), free_count_(0),
+        next_block_size_(kMinBlockSize) {}
+  // 블록의 소유권이 하나의 트리에만 있도록 복사 금지
+  SlabAllocator(const SlabAllocator &) = delete;
+  SlabAllocator &operator=(const SlabAllocator &) = delete;
+  ~SlabAllocator() { Release(); }
+
+  /**
+   * 기능 : 노드 할당 함수
+   * 동작 : free list에 재사용할 슬롯이 있으면 꺼내 쓰고, 없으면 현재 블록에서 다음 슬롯을 사용
+   * 입력값 : args - 노드 생성자에 전달할 인자
+   * 결과값 : 생성된 노드의 포인터
+   */
+  template <typename... Args> NodeType *Allocate(Args &&...args) {
+    Slot *slot;
+    if (free_list_) {
+      slot = free_list_;
+      free_list_ = free_list_->next;
+      free_count_--;
+    } else {
+      if (cursor_ == end_)
+        AddBlock(next_block_size_);
+      slot = cursor_++;
+    }
+    return new (slot->storage) NodeType(std::forward<Args>(args)...);
+  }
+
+  // 노드를 소멸시키고 슬롯을 free list에 반환
+  void Deallocate(NodeType *node) {
+    node->~NodeType();
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = free_list_;
+    free_list_ = slot;
+    free_count_++;
+  }
+
+  /**
+   * 기능 : 노드 슬롯 예약 함수
+   * 동작 : 남은 슬롯이 count개보다 적으면 부족한 만큼의 블록을 한 번에 할당
+   * 입력값 : count - 추가 할당 없이 사용할 노드 개수
+   * 결과값 : 없음
+   */
+  void Reserve(int count) {
+    int available = free_count_ + static_cast<int>(end_ - cursor_);
+    if (available < count)
+      AddBlock(count - available);
+  }
+
+  // 모든 블록을 해제 (노드의 소멸자는 호출하지 않음)
+  void Release() {
+    for (Slot *block : blocks_)
+      delete[] block;
+    blocks_.clear();
+    free_list_ = nullptr;
+    cursor_ = end_ = nullptr;
+    free_count_ = 0;
+    next_block_size_ = kMinBlockSize;
+  }
+
+private:
+  static constexpr int kMinBlockSize = 64;    // 첫 블록의 노드 개수
+  static constexpr int kMaxBlockSize = 65536; // 블록 하나의 최대 노드 개수
+
+  // 사용 중에는 노드를, 해제된 후에는 free list의 다음 슬롯을 저장
+  union Slot {
+    Slot *next;
+    alignas(NodeType) unsigned char storage[sizeof(NodeType)];
+  };
+
+  /**
+   * 기능 : 새 블록 할당 함수
+   * 동작 : 현재 블록의 남은 슬롯을 free list로 옮기고, size개의 슬롯을 가진 블록을 새로 할당
+   * 입력값 : size - 새 블록의 슬롯 개수
+   * 결과값 : 없음
+   */
+  void AddBlock(int size) {
+    while (cursor_ != end_) {
+      cursor_->next = free_list_;
+      free_list_ = cursor_++;
+      free_count_++;
+    }
+    Slot *block = new Slot[size];
+    blocks_.push_back(block);
+    cursor_ = block;
+    end_ = block + size;
+    if (next_block_size_ < kMaxBlockSize)
+      next_block_size_ *= 2;
+  }
+
+  std::vector<Slot *> blocks_; // 할당된 블록 목록
+  Slot *free_list_;            // 재사용 가능한 슬롯 목록
+  Slot *cursor_;               // 현재 블록에서 다음에 사용할 슬롯
+  Slot *end_;                  // 현재 블록의 끝
+  int free_count_;             // free list의 슬롯 개수
+  int next_block_size_;        // 다음 블록의 슬롯 개수
+};
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+
+#ifndef NODE_HANDLE_H_
+#define NODE_HANDLE_H_
+
+#include <type_traits>
+
+/**
+ * 노드 핸들 클래스
+ * 기능 : 트리에서 떼어낸 노드 하나를 소유하며, 같은 종류의 다른 트리에 재할당 없이 다시 연결
+ * 설명 :
+ * - AvlTree::extract로 얻고 AvlTree::insert로 넘기며, 이동만 가능
+ * - 트리에 연결되지 않은 채 소멸하면 노드를 해제하므로, 노드를 꺼낸 트리와 무관하게 해제할 수 있는
+ *   상태가 없는 할당자에서만 사용 가능
+ */
+template <typename NodeType, template <typename> class Alloc>
+class NodeHandle {
+  static_assert(std::is_empty<Alloc<NodeType>>::value,
+                "트리 사이에서 노드를 옮기려면 상태가 없는 할당자가 필요합니다");
+
+public:
+  using value_type = typename NodeType::KeyType;
+
+  NodeHandle() : node_(nullptr) {}
+  explicit NodeHandle(NodeType *node) : node_(node) {}
+  NodeHandle(NodeHandle &&other) noexcept : node_(other.node_) {
+    other.node_ = nullptr;
+  }
+  NodeHandle &operator=(NodeHandle &&other) noexcept {
+    if (this != &other) {
+      Reset();
+      node_ = other.node_;
+      other.node_ = nullptr;
+    }
+    return *this;
+  }
+  ~NodeHandle() { Reset(); }
+
+  bool empty() const { return node_ == nullptr; }
+  explicit operator bool() const { return node_ != nullptr; }
+  // 핸들이 가진 키 (empty()이면 사용 불가)
+  const value_type &value() const { return node_->GetKey(); }
+
+  // 소유권을 넘기고 노드 포인터를 반환 (트리에 연결할 때 사용)
+  NodeType *Release() {
+    NodeType *node = node_;
+    node_ = nullptr;
+    return node;
+  }
+
+private:
+  void Reset() {
+    if (node_)
+      Alloc<NodeType>().Deallocate(node_);
+    node_ = nullptr;
+  }
+
+  NodeType *node_; // 소유한 노드 (부모, 자식이 없는 상태)
+};
+
+#endif
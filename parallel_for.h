@@ -0,0 +1,277 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef PARALLEL_FOR_H_
+#define PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ParallelFor에서 한 번에 가져가는 기본 작업 개수
+constexpr size_t kParallelForChunk = 1024;
+
+/**
+ * 작업 훔치기 스레드 풀 클래스
+ * 기능 : ParallelFor가 호출마다 스레드를 만들고 합치지 않도록 작업 스레드를 한 번 만들어 재사용
+ * 설명 :
+ * - 작업 스레드는 처음 필요할 때 만들어지고, 프로그램이 끝날 때까지 조건 변수에서 다음 작업을 기다림
+ * - 조각들을 참여 스레드 수만큼의 연속 구간으로 나누어 슬롯마다 배분하고, 각 스레드는 자기 구간의
+ *   앞에서부터 조각을 처리하다가 비면 다른 슬롯 구간의 뒤쪽 절반을 훔쳐 옴
+ * - 슬롯의 구간은 [begin, end) 조각 번호를 64-bit 하나에 담아 CAS로 갱신
+ * - 한 번에 한 작업만 실행하며, 작업 안에서 다시 ParallelFor를 호출하면 그 스레드에서 바로 실행
+ * - 조각 처리 중 예외가 발생하면 남은 조각은 건너뛰고, 모든 스레드가 끝난 뒤 첫 예외를 호출한 스레드에서 다시 던짐
+ */
+class ThreadPool {
+public:
+  static ThreadPool &Instance() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_)
+      worker.join();
+  }
+
+  // 현재 스레드가 풀의 작업을 실행 중인지 여부
+  static bool &InWorker() {
+    static thread_local bool in_worker = false;
+    return in_worker;
+  }
+
+  /**
+   * 기능 : [0, count) 구간을 thread_count개의 스레드가 나누어 처리하는 함수
+   * 동작 : 작업을 등록해 작업 스레드를 깨우고, 호출한 스레드도 0번 슬롯으로 참여한 뒤 모두 끝날 때까지 대기
+   *        (body가 예외를 던져도 작업 스레드가 모두 끝난 뒤에 반환하므로 body는 그동안 유효함)
+   * 입력값 : count - 작업 개수, chunk - 조각 크기, thread_count - 호출한 스레드를 포함한 참여 스레드 수 (2 이상),
+   *          body - 조각을 처리하는 함수
+   * 결과값 : 없음 (body가 던진 첫 예외를 다시 던짐)
+   */
+  template <typename Body>
+  void Run(size_t count, size_t chunk, unsigned thread_count, Body &body) {
+    std::lock_guard<std::mutex> submit(submit_mutex_);
+    Grow(thread_count - 1);
+    uint64_t chunks = (count + chunk - 1) / chunk;
+    for (unsigned slot = 0; slot < thread_count; slot++) {
+      uint64_t begin = chunks * slot / thread_count;
+      uint64_t end = chunks * (slot + 1) / thread_count;
+      ranges_[slot].bounds.store(begin << 32 | end, std::memory_order_relaxed);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = {&Invoke<Body>, &body, count, chunk, thread_count};
+      active_ = thread_count - 1;
+      failed_.store(false, std::memory_order_relaxed);
+      generation_++;
+    }
+    wake_.notify_all();
+
+    InWorker() = true;
+    Work(0);
+    InWorker() = false;
+    std::exception_ptr error;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait(lock, [this] { return active_ == 0; });
+      error = std::move(error_);
+      error_ = nullptr;
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+private:
+  // 슬롯마다 캐시 라인을 따로 사용하여 거짓 공유를 막음
+  struct alignas(64) Range {
+    std::atomic<uint64_t> bounds; // 상위 32-bit : begin, 하위 32-bit : end
+  };
+
+  struct Job {
+    void (*invoke)(void *body, size_t begin, size_t end);
+    void *body;
+    size_t count;
+    size_t chunk;
+    unsigned participants; // 호출한 스레드를 포함한 참여 스레드 수
+  };
+
+  ThreadPool() = default;
+
+  template <typename Body>
+  static void Invoke(void *body, size_t begin, size_t end) {
+    (*static_cast<Body *>(body))(begin, end);
+  }
+
+  // 작업 스레드를 count개까지 늘림 (실행 중인 작업이 없을 때만 호출)
+  void Grow(unsigned count) {
+    if (workers_.size() >= count)
+      return;
+    std::unique_ptr<Range[]> ranges(new Range[count + 1]);
+    ranges_ = std::move(ranges);
+    uint64_t generation;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      generation = generation_;
+    }
+    for (unsigned slot = static_cast<unsigned>(workers_.size()) + 1;
+         slot <= count; slot++)
+      workers_.emplace_back([this, slot, generation] { Loop(slot, generation); });
+  }
+
+  // 작업 스레드 : 새 작업이 등록될 때마다 자기 슬롯으로 참여
+  void Loop(unsigned slot, uint64_t seen) {
+    InWorker() = true;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_)
+        return;
+      seen = generation_;
+      if (slot >= job_.participants)
+        continue;
+      lock.unlock();
+      Work(slot);
+      lock.lock();
+      if (--active_ == 0)
+        done_.notify_one();
+    }
+  }
+
+  // 자기 구간과 훔쳐 온 구간의 조각을 더 이상 남은 조각이 없을 때까지 처리
+  // (예외는 밖으로 내보내지 않고 첫 예외만 error_에 남긴 뒤 모든 스레드가 남은 조각을 건너뜀)
+  void Work(unsigned slot) {
+    uint64_t index;
+    try {
+      while (!failed_.load(std::memory_order_relaxed) &&
+             (Pop(slot, index) || Steal(slot, index))) {
+        size_t begin = static_cast<size_t>(index) * job_.chunk;
+        job_.invoke(job_.body, begin, std::min(begin + job_.chunk, job_.count));
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_)
+        error_ = std::current_exception();
+      failed_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // 자기 구간의 맨 앞 조각을 가져옴
+  bool Pop(unsigned slot, uint64_t &index) {
+    std::atomic<uint64_t> &bounds = ranges_[slot].bounds;
+    uint64_t cur = bounds.load(std::memory_order_relaxed);
+    for (;;) {
+      uint64_t begin = cur >> 32, end = cur & 0xffffffffu;
+      if (begin >= end)
+        return false;
+      if (bounds.compare_exchange_weak(cur, (begin + 1) << 32 | end)) {
+        index = begin;
+        return true;
+      }
+    }
+  }
+
+  // 다른 슬롯 구간의 뒤쪽 절반을 훔쳐 첫 조각은 바로 처리하고 나머지는 자기 구간으로 둠
+  bool Steal(unsigned slot, uint64_t &index) {
+    unsigned participants = job_.participants;
+    for (unsigned i = 1; i < participants; i++) {
+      std::atomic<uint64_t> &bounds =
+          ranges_[(slot + i) % participants].bounds;
+      uint64_t cur = bounds.load(std::memory_order_relaxed);
+      for (;;) {
+        uint64_t begin = cur >> 32, end = cur & 0xffffffffu;
+        if (begin >= end)
+          break;
+        uint64_t mid = end - (end - begin + 1) / 2;
+        if (bounds.compare_exchange_weak(cur, begin << 32 | mid)) {
+          // 자기 구간은 비어 있으므로 다른 스레드가 동시에 바꾸지 않음
+          ranges_[slot].bounds.store((mid + 1) << 32 | end);
+          index = mid;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  std::vector<std::thread> workers_;  // 작업 스레드 (i번 스레드는 i + 1번 슬롯)
+  std::unique_ptr<Range[]> ranges_;   // 슬롯별 남은 조각 구간
+  Job job_{};                         // 현재 작업
+  uint64_t generation_ = 0;           // 작업이 등록될 때마다 1 증가
+  unsigned active_ = 0;               // 아직 끝나지 않은 작업 스레드 수
+  bool stop_ = false;
+  std::exception_ptr error_;          // 현재 작업에서 처음 발생한 예외
+  std::atomic<bool> failed_{false};   // 현재 작업에서 예외가 발생했는지 여부
+  std::mutex mutex_;                  // job_, generation_, active_, stop_, error_ 보호
+  std::condition_variable wake_;      // 작업 스레드를 깨움
+  std::condition_variable done_;      // 작업 스레드가 모두 끝났음을 알림
+  std::mutex submit_mutex_;           // 한 번에 한 작업만 등록
+};
+
+/**
+ * 기능 : [0, count) 구간을 여러 스레드가 나누어 처리하는 함수
+ * 동작 : 구간을 chunk 크기의 조각으로 나누어 ThreadPool의 작업 스레드와 호출한 스레드가 처리
+ *        (먼저 끝난 스레드가 다른 스레드의 남은 조각을 훔쳐 오므로 질의마다 비용이 달라도 부하가 고르게 분산됨)
+ *        스레드 풀은 프로세스에 하나이고 한 번에 한 작업만 실행하므로, 여러 스레드에서 동시에 호출하면
+ *        호출이 차례로 처리됨 (작업 안에서의 중첩 호출은 기다리지 않고 그 스레드에서 바로 실행)
+ * 입력값 : count - 작업 개수, body - 조각을 처리하는 함수, thread_count - 스레드 수 (0이면 하드웨어 스레드 수), chunk - 조각 크기
+ * 결과값 : 없음 (body가 예외를 던지면 남은 조각을 건너뛰고 모든 스레드가 끝난 뒤 첫 예외를 다시 던짐)
+ */
+template <typename Body>
+void ParallelFor(size_t count, Body body, unsigned thread_count = 0,
+                 size_t chunk = kParallelForChunk) {
+  if (thread_count == 0)
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  chunk = std::max<size_t>(chunk, 1);
+  // 조각 번호는 32-bit로 표현
+  while ((count + chunk - 1) / chunk > 0xffffffffu)
+    chunk *= 2;
+  size_t chunks = (count + chunk - 1) / chunk;
+  thread_count = static_cast<unsigned>(
+      std::min<size_t>(thread_count, chunks));
+  if (thread_count <= 1 || ThreadPool::InWorker()) {
+    if (count > 0)
+      body(size_t(0), count);
+    return;
+  }
+  ThreadPool::Instance().Run(count, chunk, thread_count, body);
+}
+
+#endif
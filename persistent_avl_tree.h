@@ -0,0 +1,359 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef PERSISTENT_AVL_TREE_H_
+#define PERSISTENT_AVL_TREE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+/**
+ * 영속(persistent) AVL 트리 클래스
+ * 기능 : 수정 시 경로 복사로 새 버전을 만들고, 이전 버전은 그대로 남기는 AVL 트리
+ * 설명 :
+ * - 노드는 만들어진 뒤 바뀌지 않으며 참조 카운트로 여러 버전이 공유
+ * - Insert/Erase는 루트부터 수정 위치까지 O(log n)개의 노드만 새로 만듦
+ * - Snapshot()은 루트의 참조 카운트만 올리므로 O(1)이며, 스냅샷은 다른 스레드에서 읽고 해제해도 안전
+ * - 부모 포인터가 없으므로(여러 버전이 노드를 공유) 부모를 따라가는 질의는 제공하지 않음
+ * - AvlTree<T>와 같은 질의 결과(깊이 + 높이, 랭크)를 반환
+ */
+template <typename T> class PersistentAvlTree {
+public:
+  // 버전 사이에 공유되는 불변 노드
+  struct Node {
+    T key;
+    const Node *child[2]; // child[0] : 왼쪽, child[1] : 오른쪽
+    int height;
+    int rank;
+    mutable std::atomic<int> refs; // 이 노드를 가리키는 부모/루트의 개수
+  };
+
+  PersistentAvlTree() : root_(nullptr) {}
+  // 복사는 루트만 공유하므로 O(1)
+  PersistentAvlTree(const PersistentAvlTree &other) : root_(Retain(other.root_)) {}
+  PersistentAvlTree(PersistentAvlTree &&other) noexcept : root_(other.root_) {
+    other.root_ = nullptr;
+  }
+  PersistentAvlTree &operator=(PersistentAvlTree other) {
+    std::swap(root_, other.root_);
+    return *this;
+  }
+  ~PersistentAvlTree() { Release(root_); }
+
+  // 현재 버전을 공유하는 읽기 전용 사본 (이후의 수정은 스냅샷에 보이지 않음)
+  PersistentAvlTree Snapshot() const { return *this; }
+
+  // 추가 기능
+  void Delete() {
+    Release(root_);
+    root_ = nullptr;
+  }
+
+  // 기본 기능
+  bool Empty() const { return root_ == nullptr; }
+  int Size() const { return RankOf(root_); }
+  int Height() const { return root_ ? root_->height : -1; }
+  std::pair<const Node *, int> Find(T key) const;
+  int Insert(T key);
+
+  // 고급 기능
+  std::pair<int, int> Rank(T key) const;
+  int Erase(T key);
+
+  /**
+   * 기능 : [lo, hi) 범위의 키를 오름차순으로 방문하는 함수
+   * 동작 : 범위 밖의 서브트리는 건너뛰며 중위 순회
+   * 입력값 : lo - 범위의 시작 키 (포함), hi - 범위의 끝 키 (제외), visit - 키를 받는 함수
+   * 결과값 : 없음
+   */
+  template <typename Visitor> void ForEach(T lo, T hi, Visitor visit) const {
+    const Node *stack[kMaxHeight];
+    int top = 0;
+    const Node *node = root_;
+    while (node || top > 0) {
+      // lo 이상인 노드만 쌓으며 왼쪽으로 내려감
+      while (node) {
+        if (node->key < lo) {
+          node = node->child[1];
+        } else {
+          stack[top++] = node;
+          node = node->child[0];
+        }
+      }
+      if (top == 0)
+        break;
+      node = stack[--top];
+      if (!(node->key < hi))
+        break;
+      visit(node->key);
+      node = node->child[1];
+    }
+  }
+
+private:
+  // 경로 스택의 최대 길이 (노드 수가 int 범위일 때 AVL 트리의 높이는 45 이하)
+  static constexpr int kMaxHeight = 64;
+
+  static int HeightOf(const Node *node) { return node ? node->height : 0; }
+  static int RankOf(const Node *node) { return node ? node->rank : 0; }
+
+  static const Node *Retain(const Node *node) {
+    if (node)
+      node->refs.fetch_add(1, std::memory_order_relaxed);
+    return node;
+  }
+  static void Release(const Node *node);
+
+  static const Node *MakeNode(const T &key, const Node *left,
+                              const Node *right);
+  static const Node *Balance(const T &key, const Node *left,
+                             const Node *right);
+  static const Node *InsertNode(const Node *node, const T &key);
+  static const Node *EraseNode(const Node *node, const T &key);
+  static const Node *EraseMinNode(const Node *node);
+
+  const Node *root_; // 현재 버전의 루트 노드
+};
+
+/**
+ * 기능 : 특정 키 값을 가진 노드의 깊이와 높이의 합을 계산
+ * 동작 : 루트부터 반복적으로 내려가며 해당 키 값을 가진 노드를 탐색
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 노드, 깊이 + 높이 }, 노드가 없는 경우 { nullptr, 0 }
+ */
+template <typename T>
+std::pair<const typename PersistentAvlTree<T>::Node *, int>
+PersistentAvlTree<T>::Find(T key) const {
+  int depth = 0;
+  const Node *node = root_;
+  while (node) {
+    if (key < node->key)
+      node = node->child[0];
+    else if (key > node->key)
+      node = node->child[1];
+    else
+      return {node, depth + node->height};
+    depth++;
+  }
+  return {nullptr, 0};
+}
+
+/**
+ * 기능 : 특정 키 값을 가진 노드의 깊이와 높이의 합, 랭크를 계산
+ * 동작 : 루트부터 내려가며 오른쪽으로 이동할 때마다 왼쪽 서브트리 크기 + 1을 누적
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : { 깊이 + 높이, 랭크 }, 노드가 없는 경우 { 0, 0 }
+ */
+template <typename T>
+std::pair<int, int> PersistentAvlTree<T>::Rank(T key) const {
+  int depth = 0;
+  int cur_rank = 0;
+  const Node *node = root_;
+  while (node) {
+    if (key < node->key) {
+      node = node->child[0];
+    } else if (key > node->key) {
+      cur_rank += RankOf(node->child[0]) + 1;
+      node = node->child[1];
+    } else {
+      return {depth + node->height, cur_rank + RankOf(node->child[0]) + 1};
+    }
+    depth++;
+  }
+  return {0, 0};
+}
+
+/**
+ * 기능 : 경로 복사 삽입 함수
+ * 동작 : 루트부터 삽입 위치까지의 노드만 새로 만들어 새 버전의 루트로 교체
+ * 입력값 : key - 삽입할 키 값
+ * 결과값 : 삽입된 노드 또는 이미 있던 같은 키의 노드의 깊이와 높이의 합 (그 노드가 루트이면 0)
+ */
+template <typename T> int PersistentAvlTree<T>::Insert(T key) {
+  std::pair<const Node *, int> found = Find(key);
+  if (found.first)
+    return found.first == root_ ? 0 : found.second;
+  const Node *new_root = InsertNode(root_, key);
+  Release(root_);
+  root_ = new_root;
+  return Find(key).second;
+}
+
+/**
+ * 기능 : 경로 복사 삭제 함수
+ * 동작 : 루트부터 삭제할 노드(자식이 둘이면 후임자)까지의 노드만 새로 만들어 새 버전의 루트로 교체
+ * 입력값 : key - 삭제할 키 값
+ * 결과값 : 삭제된 노드의 깊이와 높이의 합, 노드가 없는 경우 0
+ */
+template <typename T> int PersistentAvlTree<T>::Erase(T key) {
+  int sum = Find(key).second;
+  if (sum == 0)
+    return 0;
+  const Node *new_root = EraseNode(root_, key);
+  Release(root_);
+  root_ = new_root;
+  return sum;
+}
+
+/**
+ * 기능 : 노드의 참조를 해제하는 함수
+ * 동작 : 참조 카운트를 줄이고, 마지막 참조였다면 자식의 참조를 해제한 뒤 노드를 삭제
+ * 입력값 : node - 참조를 해제할 노드 (nullptr 가능)
+ * 결과값 : 없음
+ */
+template <typename T> void PersistentAvlTree<T>::Release(const Node *node) {
+  if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Release(node->child[0]);
+    Release(node->child[1]);
+    delete node;
+  }
+}
+
+/**
+ * 기능 : 새 노드를 만드는 함수
+ * 동작 : 자식의 참조 카운트를 올리고, 자식의 높이와 랭크로 새 노드의 높이와 랭크를 계산
+ * 입력값 : key - 노드의 키 값, left, right - 자식 노드 (호출자의 참조는 그대로 유지)
+ * 결과값 : 참조 카운트가 1인 새 노드
+ */
+template <typename T>
+const typename PersistentAvlTree<T>::Node *
+PersistentAvlTree<T>::MakeNode(const T &key, const Node *left,
+                               const Node *right) {
+  return new Node{key,
+                  {Retain(left), Retain(right)},
+                  1 + std::max(HeightOf(left), HeightOf(right)),
+                  1 + RankOf(left) + RankOf(right),
+                  {1}};
+}
+
+/**
+ * 기능 : 균형을 맞춘 새 노드를 만드는 함수
+ * 동작 : 양쪽 높이 차이가 2이면 AvlTree::ReBalanceTree와 같은 기준으로 회전한 모양의 노드들을 새로 만듦
+ * 입력값 : key - 노드의 키 값, left, right - 높이 차이가 2 이하인 자식 노드
+ * 결과값 : 참조 카운트가 1인 서브트리의 새 루트
+ */
+template <typename T>
+const typename PersistentAvlTree<T>::Node *
+PersistentAvlTree<T>::Balance(const T &key, const Node *left,
+                              const Node *right) {
+  int balance = HeightOf(left) - HeightOf(right);
+  const Node *a, *b, *result;
+  if (balance > 1) {
+    if (HeightOf(left->child[0]) >= HeightOf(left->child[1])) {
+      // LL 회전
+      b = MakeNode(key, left->child[1], right);
+      result = MakeNode(left->key, left->child[0], b);
+      Release(b);
+    } else {
+      // LR 회전
+      const Node *pivot = left->child[1];
+      a = MakeNode(left->key, left->child[0], pivot->child[0]);
+      b = MakeNode(key, pivot->child[1], right);
+      result = MakeNode(pivot->key, a, b);
+      Release(a);
+      Release(b);
+    }
+    return result;
+  }
+  if (balance < -1) {
+    if (HeightOf(right->child[1]) >= HeightOf(right->child[0])) {
+      // RR 회전
+      a = MakeNode(key, left, right->child[0]);
+      result = MakeNode(right->key, a, right->child[1]);
+      Release(a);
+    } else {
+      // RL 회전
+      const Node *pivot = right->child[0];
+      a = MakeNode(key, left, pivot->child[0]);
+      b = MakeNode(right->key, pivot->child[1], right->child[1]);
+      result = MakeNode(pivot->key, a, b);
+      Release(a);
+      Release(b);
+    }
+    return result;
+  }
+  return MakeNode(key, left, right);
+}
+
+// key가 없는 서브트리에 key를 넣은 새 서브트리를 반환 (node의 참조는 유지)
+template <typename T>
+const typename PersistentAvlTree<T>::Node *
+PersistentAvlTree<T>::InsertNode(const Node *node, const T &key) {
+  if (!node)
+    return MakeNode(key, nullptr, nullptr);
+  const Node *child, *result;
+  if (key < node->key) {
+    child = InsertNode(node->child[0], key);
+    result = Balance(node->key, child, node->child[1]);
+  } else {
+    child = InsertNode(node->child[1], key);
+    result = Balance(node->key, node->child[0], child);
+  }
+  Release(child);
+  return result;
+}
+
+// key가 있는 서브트리에서 key를 뺀 새 서브트리를 반환 (node의 참조는 유지)
+template <typename T>
+const typename PersistentAvlTree<T>::Node *
+PersistentAvlTree<T>::EraseNode(const Node *node, const T &key) {
+  const Node *child, *result;
+  if (key < node->key) {
+    child = EraseNode(node->child[0], key);
+    result = Balance(node->key, child, node->child[1]);
+  } else if (key > node->key) {
+    child = EraseNode(node->child[1], key);
+    result = Balance(node->key, node->child[0], child);
+  } else if (!node->child[0] || !node->child[1]) {
+    // 자식이 하나 이하인 경우, 자식이 삭제할 노드의 자리를 대신함
+    return Retain(node->child[0] ? node->child[0] : node->child[1]);
+  } else {
+    // 자식이 둘인 경우, 후임자의 키로 삭제할 노드의 자리를 만듦
+    const Node *successor = node->child[1];
+    while (successor->child[0])
+      successor = successor->child[0];
+    child = EraseMinNode(node->child[1]);
+    result = Balance(successor->key, node->child[0], child);
+  }
+  Release(child);
+  return result;
+}
+
+// 서브트리에서 최솟값 노드를 뺀 새 서브트리를 반환 (node의 참조는 유지)
+template <typename T>
+const typename PersistentAvlTree<T>::Node *
+PersistentAvlTree<T>::EraseMinNode(const Node *node) {
+  if (!node->child[0])
+    return Retain(node->child[1]);
+  const Node *child = EraseMinNode(node->child[0]);
+  const Node *result = Balance(node->key, child, node->child[1]);
+  Release(child);
+  return result;
+}
+
+#endif
@@ -28,57 +28,270 @@ Date : 2024-11-26
 #ifndef SET_H_
 #define SET_H_
 
+#include "compare.h"
 #include "node.h"
+#include "node_allocator.h"
+#include "parallel_for.h"
+#include "set_iterator.h"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 /**
  * 이진 탐색 트리 클래스
  * 기능 : 기본 이진 탐색
  * 설명 :
  * - 이진 탐색 기능을 하는 클래스. AVL트리에 기본 기능을 상속해주는 역할
+ * - 가상 함수가 없어 Insert, Erase 등은 서브클래스의 함수가 정적으로 호출되어 인라인 가능
+ *   (가상 함수 인터페이스가 필요하면 아래의 Set, SetAdapter 사용)
  * - 기본 기능 + 고급 기능 + 
  * 추가 기능(기본, 고급 기능을 구현하는데 도움을 주는 기능)으로 구성
  * - 기본 기능과 고급 기능은 사용자 인터페이스 부분과 구현 부분으로 나누어짐
+ * - 노드의 할당과 해제는 Alloc 정책(기본값 NodeAllocator)이 담당
+ * - Augment 정책이 있으면 노드마다 서브트리 집계값을 유지 (augment.h 참고)
+ * - 키 비교는 Compare 정책(기본값 ThreeWayCompare)으로 노드마다 한 번만 수행하며,
+ *   탐색 함수는 Compare가 받는 다른 타입의 키로도 호출 가능 (compare.h 참고)
  */
-template <typename T> class Set {
+template <typename T, template <typename> class Alloc = NodeAllocator,
+          typename Augment = NoAugment, typename Compare = ThreeWayCompare>
+class SetCore {
 public:
-  Set() : root_(nullptr), size_(0) {}
-  virtual ~Set() { Delete(); }
+  using NodeType = Node<T, Augment>;
+  using iterator = SetIterator<NodeType>;
+  using const_iterator = iterator;
+  using value_type = T;
+
+  SetCore() : root_(nullptr), size_(0), max_node_(nullptr) {}
 
   // 추가 기능
-  void Delete() { DeleteTree(root_); }
+  void Delete() {
+    // 블록 단위 해제가 가능하고 노드(키와 집계값)의 소멸자가 없으면 노드 순회를 생략
+    if constexpr (Alloc<NodeType>::kBulkRelease &&
+                  std::is_trivially_destructible<NodeType>::value)
+      allocator_.Release();
+    else
+      DeleteTree(root_);
+    root_ = nullptr;
+    size_ = 0;
+    max_node_ = nullptr;
+  }
+  // count개의 노드를 추가 할당 없이 삽입할 수 있도록 미리 확보
+  void Reserve(int count) { allocator_.Reserve(count); }
   // 트리의 루트 노드를 수정해야 할 때
-  Node<T> *&GetRoot() { return root_; }
+  NodeType *&GetRoot() { return root_; }
 
   // 수정하지 않고 루트를 읽기만 할 때
-  const Node<T> *GetRoot() const { return root_; }
+  const NodeType *GetRoot() const { return root_; }
 
-  Node<T> *GetMinNode() { return FindMinNode(root_); }
-  Node<T> *GetMaxNode() { return FindMaxNode(root_); }
+  NodeType *GetMinNode() { return FindMinNode(root_); }
+  NodeType *GetMaxNode() { return MaxNode(); }
 
   // 기본 기능
   bool Empty() const { return root_ == nullptr; }
   int Size() const { return size_; }
   int Height() const { return root_ ? root_->GetHeight() : -1; }
   // 초기 root 노드의 높이가 1부터
-  std::pair<Node<T> *, int> Find(T key) const {
+  template <typename K> std::pair<NodeType *, int> Find(const K &key) const {
     return FindNode(root_, key, 0);
   }
-  std::pair<int, int> Ancestor(T key) const { return AncestorNode(key); }
-  int Average(T key) const { return AverageNode(key); }
-
-  // 서브클래스에서 overriding
-  virtual int Insert(T key) = 0;
-  virtual int Erase(T key) = 0;
+  // 핑거 탐색 : hint 위치에서 출발해 key를 찾음 (없으면 end())
+  template <typename K> iterator Find(iterator hint, const K &key) const {
+    NodeType *node = FingerNode(hint.GetNode(), key);
+    for (int order; node && (order = compare_(key, node->GetKey())) != 0;)
+      node = order < 0 ? node->GetLeft() : node->GetRight();
+    return MakeIterator(node);
+  }
+  std::pair<int, int> Ancestor(const T &key) const { return AncestorNode(key); }
+  int Average(const T &key) const { return AverageNode(key); }
 
   // 고급 기능 : Rank 함수
-  std::pair<int, int> Rank(T key) const {
+  template <typename K> std::pair<int, int> Rank(const K &key) const {
     return GetNodeRank(root_, key, 0, 0);
   }
 
+  // 순서 통계 기능 : 순위는 Rank와 같이 1부터 시작
+  NodeType *Select(int k) const { return SelectNode(k); }
+  template <typename K> int RankOfBound(const K &key) const {
+    return CountLess(key);
+  }
+  // [lo, hi) 범위에 있는 키의 개수
+  int CountRange(const T &lo, const T &hi) const {
+    return Less(lo, hi) ? CountLess(hi) - CountLess(lo) : 0;
+  }
+  NodeType *Quantile(double q) const { return QuantileNode(q); }
+
+  /**
+   * 기능 : 모든 노드를 중위 순서로 방문하는 함수
+   * 동작 : 스택으로 왼쪽 경로를 쌓으며 반복적으로 중위 순회하고, 각 노드와 그 깊이(루트는 0)를 visit에 넘김
+   * 입력값 : visit - (const NodeType &, int)를 받는 함수
+   * 결과값 : 없음
+   */
+  template <typename Visitor> void ForEachNode(Visitor visit) const {
+    std::vector<std::pair<const NodeType *, int>> stack;
+    const NodeType *node = root_;
+    int depth = 0;
+    while (node || !stack.empty()) {
+      for (; node; node = node->GetLeft())
+        stack.push_back({node, depth++});
+      node = stack.back().first;
+      depth = stack.back().second;
+      stack.pop_back();
+      visit(*node, depth);
+      node = node->GetRight();
+      depth++;
+    }
+  }
+
+  // 일괄 질의 기능 : 여러 질의를 한 단계씩 함께 진행하며 다음 노드를 미리 읽어 캐시 미스 대기를 겹침
+  // (결과는 Find(keys[i]).second, Rank(keys[i])와 같음)
+  void FindBatch(const T *keys, size_t count, int *results) const {
+    LockstepSearch<false>(keys, count, [results](size_t i, int sum, int) {
+      results[i] = sum;
+    });
+  }
+  void RankBatch(const T *keys, size_t count,
+                 std::pair<int, int> *results) const {
+    LockstepSearch<true>(keys, count, [results](size_t i, int sum, int rank) {
+      results[i] = {sum, rank};
+    });
+  }
+
+  // 병렬 일괄 질의 기능 : 수정되지 않는 트리에 대해 keys[i]의 결과를 results[i]에 저장
+  // (thread_count가 0이면 하드웨어 스레드 수만큼 사용)
+  void ParallelFind(const T *keys, size_t count, int *results,
+                    unsigned thread_count = 0) const {
+    ParallelFor(
+        count,
+        [&](size_t begin, size_t end) {
+          FindBatch(keys + begin, end - begin, results + begin);
+        },
+        thread_count);
+  }
+  void ParallelRank(const T *keys, size_t count, std::pair<int, int> *results,
+                    unsigned thread_count = 0) const {
+    ParallelFor(
+        count,
+        [&](size_t begin, size_t end) {
+          RankBatch(keys + begin, end - begin, results + begin);
+        },
+        thread_count);
+  }
+  void ParallelAncestor(const T *keys, size_t count,
+                        std::pair<int, int> *results,
+                        unsigned thread_count = 0) const {
+    ParallelFor(
+        count,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; i++)
+            results[i] = AncestorNode(keys[i]);
+        },
+        thread_count);
+  }
+  void ParallelAverage(const T *keys, size_t count, int *results,
+                       unsigned thread_count = 0) const {
+    ParallelFor(
+        count,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; i++)
+            results[i] = AverageNode(keys[i]);
+        },
+        thread_count);
+  }
+
+  // 반복자 기능 : 키의 오름차순으로 순회 (std::set과 같은 이름과 의미)
+  iterator begin() const { return MakeIterator(GetMin()); }
+  iterator end() const { return MakeIterator(nullptr); }
+  // key 이상인 첫 위치
+  template <typename K> iterator lower_bound(const K &key) const {
+    return MakeIterator(BoundNode(key, false));
+  }
+  // key 초과인 첫 위치
+  template <typename K> iterator upper_bound(const K &key) const {
+    return MakeIterator(BoundNode(key, true));
+  }
+  template <typename K>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+  // key보다 큰 키 중 최솟값 노드 (key가 트리에 없어도 동작), 없으면 nullptr
+  NodeType *Successor(const T &key) const { return BoundNode(key, true); }
+  // key보다 작은 키 중 최댓값 노드, 없으면 nullptr
+  NodeType *Predecessor(const T &key) const {
+    iterator it = lower_bound(key);
+    return it == begin() ? nullptr : (--it).GetNode();
+  }
+  // [lo, hi) 범위의 키를 묶음 단위로 읽는 커서
+  RangeCursor<NodeType> Scan(const T &lo, const T &hi) const {
+    return RangeCursor<NodeType>(lower_bound(lo), Less(lo, hi)
+                                                      ? lower_bound(hi)
+                                                      : lower_bound(lo));
+  }
+
+  /**
+   * 기능 : [lo, hi) 범위 키들의 집계값을 계산하는 함수 (Augment 정책이 있을 때만 사용 가능)
+   * 동작 : 범위가 갈라지는 노드를 찾은 뒤, 양쪽 경계를 따라 내려가며 범위에 완전히 포함된 서브트리의 집계값을 합침
+   * 입력값 : lo - 범위의 시작 키 (포함), hi - 범위의 끝 키 (제외)
+   * 결과값 : 범위의 집계값, 범위에 키가 없으면 std::nullopt
+   */
+  template <typename A = Augment>
+  std::optional<typename A::Value> RangeAggregate(const T &lo,
+                                                  const T &hi) const {
+    using Value = typename A::Value;
+    // 1. 범위에 포함되는 첫 노드(갈라지는 노드)까지 하강
+    NodeType *split = root_;
+    while (split && (Less(split->GetKey(), lo) || !Less(split->GetKey(), hi)))
+      split = Less(split->GetKey(), lo) ? split->GetRight() : split->GetLeft();
+    if (!split)
+      return std::nullopt;
+
+    // 2. 왼쪽 경계 : lo 이상인 노드와 그 오른쪽 서브트리를 앞쪽에 합침
+    Value result = A::FromKey(split->GetKey());
+    for (NodeType *node = split->GetLeft(); node;) {
+      if (!Less(node->GetKey(), lo)) {
+        Value piece = A::FromKey(node->GetKey());
+        if (node->GetRight())
+          piece = A::Combine(piece, node->GetRight()->GetAggregate());
+        result = A::Combine(piece, result);
+        node = node->GetLeft();
+      } else {
+        node = node->GetRight();
+      }
+    }
+
+    // 3. 오른쪽 경계 : hi 미만인 노드와 그 왼쪽 서브트리를 뒤쪽에 합침
+    for (NodeType *node = split->GetRight(); node;) {
+      if (Less(node->GetKey(), hi)) {
+        Value piece = A::FromKey(node->GetKey());
+        if (node->GetLeft())
+          piece = A::Combine(node->GetLeft()->GetAggregate(), piece);
+        result = A::Combine(result, piece);
+        node = node->GetRight();
+      } else {
+        node = node->GetLeft();
+      }
+    }
+    return result;
+  }
+
 protected:
-  Node<T> *root_; // 트리의 루트 노드
-  int size_;      // 트리의 노드 개수를 저장하는 멤버 변수
+  // SetCore 포인터로 삭제하지 않으므로 가상 소멸자가 필요 없음
+  ~SetCore() { Delete(); }
+
+  NodeType *root_;            // 트리의 루트 노드
+  int size_;                 // 트리의 노드 개수를 저장하는 멤버 변수
+  // 최댓값 노드 캐시 (nullptr이면 다음 MaxNode 호출 때 다시 구함)
+  // 삽입/삭제는 직접 갱신하고, 루트를 통째로 바꾸는 연산(Delete, TakeRoot, SetRoot)은 비움
+  mutable NodeType *max_node_;
+  Alloc<NodeType> allocator_; // 노드 할당자
+  Compare compare_;           // 키 비교 정책
+
+  // 3-way 비교로 a < b 판단
+  template <typename A, typename B> bool Less(const A &a, const B &b) const {
+    return compare_(a, b) < 0;
+  }
 
   /**
    * 기능 : node가 루트인 부분트리에서 노드들의 key_ 값 중 최솟값 리턴
@@ -86,42 +299,191 @@ protected:
    * 입력값 : node - 찾고자 하는 부분트리의 루트
    * 결과값 : key_값이 최소인 node 리턴
    */
-  Node<T> *FindMinNode(Node<T> *node) const {
+  NodeType *FindMinNode(NodeType *node) const {
     while (node->GetLeft() != nullptr)
       node = node->GetLeft();
     return node;
   }
 
-private:
+  // 최댓값 노드 (캐시가 비어 있을 때만 루트에서 내려감), 트리가 비어 있으면 nullptr
+  NodeType *MaxNode() const {
+    if (!max_node_ && root_)
+      max_node_ = FindMaxNode(root_);
+    return max_node_;
+  }
+
+  /**
+   * 기능 : 핑거 탐색의 출발 노드를 찾는 함수
+   * 동작 : finger에서 부모 포인터를 따라 올라가며, key가 서브트리의 키 범위 안에 들어오는 첫 조상을 찾음
+   * 입력값 : finger - 탐색을 시작할 노드 (nullptr이면 최댓값 노드), key - 찾을 키
+   * 결과값 : key를 찾기 위해 내려가기 시작할 서브트리의 루트 (key와 같은 노드를 만나면 그 노드)
+   * 설명 : 내려가는 거리는 보통 finger와 key 사이 순위 차이 d에 대해 O(log d)
+   *        (end() 힌트는 최댓값 노드 캐시를 사용하므로 루트에서 내려가지 않음)
+   */
+  template <typename K>
+  NodeType *FingerNode(NodeType *finger, const K &key) const {
+    if (!finger) {
+      // end() 힌트 : 최댓값보다 큰 키는 최댓값 노드 아래에 바로 위치
+      finger = MaxNode();
+      if (!finger || Less(finger->GetKey(), key))
+        return finger;
+    }
+    int order = compare_(key, finger->GetKey());
+    if (order == 0)
+      return finger;
+
+    // finger 서브트리의 키 범위는 진행 방향 쪽으로 처음 만나는 경계 조상까지이므로,
+    // key가 경계를 넘을 때만 그 조상으로 출발점을 옮김
+    bool to_right = order > 0;
+    NodeType *start = finger;
+    NodeType *node = finger;
+    while (NodeType *parent = node->GetParent()) {
+      if ((parent->GetLeft() == node) == to_right) {
+        int parent_order = compare_(key, parent->GetKey());
+        if (parent_order == 0)
+          return parent;
+        if (to_right ? parent_order < 0 : parent_order > 0)
+          break;
+        start = parent;
+      }
+      node = parent;
+    }
+    return start;
+  }
+
   /**
    * 기능 : Tree 삭제
    * 동작 : 순회하면서 메모리 할당 해제
    * 입력값 : 특정 node
    * 결과값 : None
    */
-  void DeleteTree(Node<T> *node) {
+  void DeleteTree(NodeType *node) {
     if (node) {
       DeleteTree(node->GetLeft());
       DeleteTree(node->GetRight());
-      delete node;
+      allocator_.Deallocate(node);
+    }
+  }
+
+  iterator MakeIterator(NodeType *node) const {
+    return iterator(node, &root_);
+  }
+
+private:
+  NodeType *GetMin() const { return root_ ? FindMinNode(root_) : nullptr; }
+
+  // LockstepSearch에서 함께 진행하는 질의 개수
+  static constexpr size_t kBatchGroup = 16;
+
+  // 곧 읽을 노드를 미리 캐시로 가져옴
+  static void PrefetchNode(const NodeType *node) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(node);
+#endif
+  }
+
+  /**
+   * 기능 : 여러 키를 함께 탐색하는 함수 (그룹 프리페치)
+   * 동작 : kBatchGroup개의 질의를 한 단계씩 번갈아 진행하며, 각 질의의 다음 노드를 프리페치한 뒤 다른 질의를 처리
+   * 입력값 : keys, count - 찾을 키 배열, store - (번호, 깊이 + 높이, 랭크)를 받는 함수 (없는 키는 0, 0)
+   * 결과값 : 없음
+   * 설명 : kWithRank가 false이면 랭크를 계산하지 않고 0을 넘김
+   */
+  template <bool kWithRank, typename Store>
+  void LockstepSearch(const T *keys, size_t count, Store store) const {
+    NodeType *cursor[kBatchGroup];
+    int depth[kBatchGroup];
+    int rank[kBatchGroup];
+    // 빈 트리에서는 모든 키가 없는 키
+    if (!root_) {
+      for (size_t i = 0; i < count; i++)
+        store(i, 0, 0);
+      return;
+    }
+    for (size_t base = 0; base < count; base += kBatchGroup) {
+      size_t group = std::min(kBatchGroup, count - base);
+      for (size_t i = 0; i < group; i++) {
+        cursor[i] = root_;
+        depth[i] = 0;
+        rank[i] = 0;
+      }
+      for (size_t active = group; active > 0;) {
+        active = 0;
+        for (size_t i = 0; i < group; i++) {
+          NodeType *node = cursor[i];
+          if (!node)
+            continue;
+          int order = compare_(keys[base + i], node->GetKey());
+          if (order == 0) {
+            int left_rank = 0;
+            if (kWithRank && node->GetLeft())
+              left_rank = node->GetLeft()->GetRank();
+            store(base + i, depth[i] + node->GetHeight(),
+                  rank[i] + left_rank + 1);
+            cursor[i] = nullptr;
+            continue;
+          }
+          if (order < 0) {
+            node = node->GetLeft();
+          } else {
+            if (kWithRank && node->GetLeft())
+              rank[i] += node->GetLeft()->GetRank();
+            rank[i]++;
+            node = node->GetRight();
+          }
+          if (node) {
+            PrefetchNode(node);
+            active++;
+          } else {
+            store(base + i, 0, 0);
+          }
+          cursor[i] = node;
+          depth[i]++;
+        }
+      }
     }
   }
 
+  /**
+   * 기능 : key 이상(strict이면 초과)인 첫 노드를 찾는 함수
+   * 동작 : 루트에서 내려가며 조건을 만족하는 노드를 만나면 후보로 기억하고 왼쪽으로 이동
+   * 입력값 : key - 기준 키, strict - true이면 key와 같은 노드는 제외
+   * 결과값 : 조건을 만족하는 가장 작은 키의 노드, 없으면 nullptr
+   */
+  template <typename K>
+  NodeType *BoundNode(const K &key, bool strict) const {
+    NodeType *result = nullptr;
+    NodeType *node = root_;
+    while (node) {
+      int order = compare_(key, node->GetKey());
+      if (strict ? order < 0 : order <= 0) {
+        result = node;
+        node = node->GetLeft();
+      } else {
+        node = node->GetRight();
+      }
+    }
+    return result;
+  }
+
   /**
    * 기능 : 특정 키 값을 가진 노드의 깊이와 높이의 합을 계산
    * 동작 : 재귀적으로 해당 키 값을 가진 노드를 찾아서 깊이와 높이의 합 반환
    * 입력값 : node - 현재 트리의 루트 노드 포인터, key - 찾고자 하는 키 값, depth - 현재 깊이
    * 결과값 : 해당 노드의 깊이와 높이의 합, 노드가 없는 경우 0
    */
-  std::pair<Node<T> *, int> FindNode(Node<T> *node, T key, int depth) const {
+  template <typename K>
+  std::pair<NodeType *, int> FindNode(NodeType *node, const K &key,
+                                      int depth) const {
     // 노드가 없으면 0 반환
     if (!node)
       return {nullptr, 0};
 
-    if (node->GetKey() == key) {
+    int order = compare_(key, node->GetKey());
+    if (order == 0) {
       // 노드의 깊이 + 높이 반환
       return {node, depth + node->GetHeight()};
-    } else if (key < node->GetKey()) {
+    } else if (order < 0) {
       return FindNode(node->GetLeft(), key, depth + 1);
     } else {
       return FindNode(node->GetRight(), key, depth + 1);
@@ -134,15 +496,18 @@ private:
    * 입력값 : node - 현재 노드, key - 찾고자 하는 키 값, depth - 현재 깊이, cur_rank - 현재까지 누적되어 계산된 랭크
    * 결과값 : { 깊이 + 높이의 합, 순위 }
    */
-  std::pair<int, int> GetNodeRank(Node<T> *node, T key, int depth, int cur_rank) const {
+  template <typename K>
+  std::pair<int, int> GetNodeRank(NodeType *node, const K &key, int depth,
+                                  int cur_rank) const {
     int sum = 0;
-    
+
     while (node) {
-      if (key < node->GetKey()) {
+      int order = compare_(key, node->GetKey());
+      if (order < 0) {
         // 왼쪽 서브트리로 이동
         node = node->GetLeft();
         depth++;
-      } else if (key > node->GetKey()) {
+      } else if (order > 0) {
         // 왼쪽 서브트리의 랭크 계산
         int left_rank = node->GetLeft() ? node->GetLeft()->GetRank() : 0;
         cur_rank += left_rank + 1;
@@ -161,15 +526,71 @@ private:
     return {0, 0};
   }
 
+  /**
+   * 기능 : k번째로 작은 키를 가진 노드를 찾는 함수
+   * 동작 : 왼쪽 서브트리의 랭크(노드 개수)와 k를 비교하며 루트부터 반복적으로 내려감
+   * 입력값 : k - 찾고자 하는 순위 (1부터 시작)
+   * 결과값 : k번째 노드, 범위를 벗어나면 nullptr
+   */
+  NodeType *SelectNode(int k) const {
+    if (k < 1 || k > size_)
+      return nullptr;
+
+    NodeType *node = root_;
+    while (node) {
+      int left_rank = node->GetLeft() ? node->GetLeft()->GetRank() : 0;
+      if (k <= left_rank) {
+        node = node->GetLeft();
+      } else if (k == left_rank + 1) {
+        return node;
+      } else {
+        k -= left_rank + 1;
+        node = node->GetRight();
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * 기능 : key보다 작은 키의 개수를 계산하는 함수
+   * 동작 : 오른쪽으로 내려갈 때마다 왼쪽 서브트리의 랭크와 현재 노드를 누적
+   * 입력값 : key - 기준 키 값 (트리에 없어도 됨)
+   * 결과값 : key보다 작은 키의 개수 (key가 삽입될 때의 순위 - 1)
+   */
+  template <typename K> int CountLess(const K &key) const {
+    int count = 0;
+    NodeType *node = root_;
+    while (node) {
+      if (Less(node->GetKey(), key)) {
+        count += (node->GetLeft() ? node->GetLeft()->GetRank() : 0) + 1;
+        node = node->GetRight();
+      } else {
+        node = node->GetLeft();
+      }
+    }
+    return count;
+  }
+
+  /**
+   * 기능 : 분위수에 해당하는 노드를 찾는 함수
+   * 동작 : nearest-rank 방식으로 순위 ceil(q * n)을 구해 (1 ~ n으로 보정) SelectNode 수행
+   * 입력값 : q - 분위 (0.0 ~ 1.0)
+   * 결과값 : 분위수 노드, 트리가 비어 있으면 nullptr
+   */
+  NodeType *QuantileNode(double q) const {
+    int k = static_cast<int>(std::ceil(q * size_));
+    return SelectNode(std::min(std::max(k, 1), size_));
+  }
+
   /**
    * 기능 : 특정 노드의 깊이와 높이의 합과 부모 노드 키 값의 합 계산
    * 동작 : 트리를 순회하며 루트까지 부모 노드 키 값을 합산
    * 입력값 : 찾고자 하는 노드의 키 값
    * 결과값 : { 깊이+높이, 루트까지 부모 노드 키 값의 합 }
    */
-  std::pair<int, int> AncestorNode(T key) const {
+  std::pair<int, int> AncestorNode(const T &key) const {
     // key 값을 가진 노드의 깊이와 높이의 합
-    std::pair<Node<T> *, int> findNode = Find(key);
+    std::pair<NodeType *, int> findNode = Find(key);
     if (!findNode.first) {
       return {0, 0};
     }
@@ -181,7 +602,7 @@ private:
       // 루트 노드까지의 key 값들의 합을 저장할 변수 초기화
       int sum = 0;
       // 부모 노드를 따라가며 key 값을 더함
-      Node<T> *current = findNode.first->GetParent();
+      NodeType *current = findNode.first->GetParent();
       while (current) {
         sum += current->GetKey();
         current = current->GetParent();
@@ -196,16 +617,22 @@ private:
    * 입력값 : 부분 트리의 루트로 사용할 키 값
    * 결과값 : 부분 트리 키 값의 산술평균
    */
-  int AverageNode(T key) const {
+  int AverageNode(const T &key) const {
     // find로 키 값에 해당하는 노드 찾기
-    std::pair<Node<T> *, int> findNode = Find(key);
+    std::pair<NodeType *, int> findNode = Find(key);
 
     if (findNode.first == nullptr)
       return 0;
 
-    // 부분 트리에서 최솟값과 최댓값 찾기
-    int minKey = FindMinNode(findNode.first)->GetKey();
-    int maxKey = FindMaxNode(findNode.first)->GetKey();
+    // 부분 트리에서 최솟값과 최댓값 찾기 (집계값이 있으면 O(1))
+    int minKey, maxKey;
+    if constexpr (HasMinMax<Augment>::value) {
+      minKey = Augment::Min(findNode.first->GetAggregate());
+      maxKey = Augment::Max(findNode.first->GetAggregate());
+    } else {
+      minKey = FindMinNode(findNode.first)->GetKey();
+      maxKey = FindMaxNode(findNode.first)->GetKey();
+    }
     // 산술평균 계산
     int average = (minKey + maxKey) / 2;
     // 결과 출력
@@ -218,11 +645,68 @@ private:
    * 입력값 : node - 찾고자 하는 부분트리의 루트
    * 결과값 : key_값이 최대인 node 리턴
    */
-  Node<T> *FindMaxNode(Node<T> *node) const {
+  NodeType *FindMaxNode(NodeType *node) const {
     while (node->GetRight() != nullptr)
       node = node->GetRight();
     return node;
   }
 };
 
+/**
+ * 집합 인터페이스 클래스
+ * 기능 : 트리 종류와 무관하게 가상 함수로 기본 기능을 호출
+ * 설명 : 실행 중에 트리 종류를 고르는 경우에만 SetAdapter와 함께 사용하며,
+ *        Find는 노드 대신 {키 존재 여부, 깊이 + 높이}를 반환
+ *        (집계 정책을 쓰는 AvlTree<T, Augment>의 Node<T, Augment>처럼 노드 형식이 Node<T>가 아닌 트리도
+ *         같은 인터페이스로 감쌀 수 있도록 노드 포인터를 노출하지 않음)
+ */
+template <typename T> class Set {
+public:
+  virtual ~Set() = default;
+
+  virtual bool Empty() const = 0;
+  virtual int Size() const = 0;
+  virtual int Height() const = 0;
+  virtual std::pair<bool, int> Find(const T &key) const = 0;
+  virtual std::pair<int, int> Rank(const T &key) const = 0;
+  virtual int Insert(const T &key) = 0;
+  virtual int Erase(const T &key) = 0;
+  virtual std::pair<int, int> Ancestor(const T &key) const = 0;
+  virtual int Average(const T &key) const = 0;
+};
+
+/**
+ * 집합 어댑터 클래스
+ * 기능 : Tree(AvlTree 등)를 소유하고 Set 인터페이스의 각 함수를 Tree의 같은 함수로 전달
+ */
+template <typename Tree>
+class SetAdapter : public Set<typename Tree::value_type> {
+public:
+  using T = typename Tree::value_type;
+
+  bool Empty() const override { return tree_.Empty(); }
+  int Size() const override { return tree_.Size(); }
+  int Height() const override { return tree_.Height(); }
+  std::pair<bool, int> Find(const T &key) const override {
+    auto result = tree_.Find(key);
+    return {result.first != nullptr, result.second};
+  }
+  std::pair<int, int> Rank(const T &key) const override {
+    return tree_.Rank(key);
+  }
+  int Insert(const T &key) override { return tree_.Insert(key); }
+  int Erase(const T &key) override { return tree_.Erase(key); }
+  std::pair<int, int> Ancestor(const T &key) const override {
+    return tree_.Ancestor(key);
+  }
+  int Average(const T &key) const override { return tree_.Average(key); }
+
+  // 감싼 트리 (Set에 없는 기능을 사용할 때)
+  Tree &GetTree() { return tree_; }
+  const Tree &GetTree() const { return tree_; }
+
+private:
+  Tree tree_;
+};
+
 #endif
\ No newline at end of file
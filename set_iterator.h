@@ -0,0 +1,169 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef SET_ITERATOR_H_
+#define SET_ITERATOR_H_
+
+#include <cstddef>
+#include <iterator>
+
+/**
+ * 중위 순회 반복자 클래스
+ * 기능 : 부모 포인터를 따라 이동하는 양방향 반복자
+ * 설명 :
+ * - ++, -- 한 번은 최악 O(log n)이지만 전체 순회는 한 단계당 분할 상환 O(1)
+ * - end()는 nullptr 노드로 표현하며, end()에서 --하면 최댓값 노드로 이동
+ * - 삽입/삭제로 다른 노드가 회전해도 가리키는 노드가 삭제되지 않았다면 유효함
+ */
+template <typename NodeType> class SetIterator {
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename NodeType::KeyType;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type *;
+  using reference = const value_type &;
+
+  SetIterator() : node_(nullptr), root_(nullptr) {}
+  SetIterator(NodeType *node, NodeType *const *root)
+      : node_(node), root_(root) {}
+
+  reference operator*() const { return node_->GetKey(); }
+  pointer operator->() const { return &node_->GetKey(); }
+  // 반복자가 가리키는 노드 (end()이면 nullptr)
+  NodeType *GetNode() const { return node_; }
+
+  SetIterator &operator++() {
+    node_ = NextNode(node_);
+    return *this;
+  }
+  SetIterator operator++(int) {
+    SetIterator prev = *this;
+    ++*this;
+    return prev;
+  }
+  SetIterator &operator--() {
+    node_ = node_ ? PrevNode(node_) : MaxNode(*root_);
+    return *this;
+  }
+  SetIterator operator--(int) {
+    SetIterator prev = *this;
+    --*this;
+    return prev;
+  }
+
+  bool operator==(const SetIterator &other) const {
+    return node_ == other.node_;
+  }
+  bool operator!=(const SetIterator &other) const {
+    return node_ != other.node_;
+  }
+
+  /**
+   * 기능 : 중위 순서상 다음 노드를 찾는 함수
+   * 동작 : 오른쪽 서브트리가 있으면 그 최솟값, 없으면 왼쪽 자식으로 올라오는 첫 조상
+   * 입력값 : node - 기준 노드
+   * 결과값 : 다음 노드, 없으면 nullptr
+   */
+  static NodeType *NextNode(NodeType *node) {
+    if (node->GetRight())
+      return MinNode(node->GetRight());
+    NodeType *parent = node->GetParent();
+    while (parent && node == parent->GetRight()) {
+      node = parent;
+      parent = parent->GetParent();
+    }
+    return parent;
+  }
+
+  /**
+   * 기능 : 중위 순서상 이전 노드를 찾는 함수
+   * 동작 : 왼쪽 서브트리가 있으면 그 최댓값, 없으면 오른쪽 자식으로 올라오는 첫 조상
+   * 입력값 : node - 기준 노드
+   * 결과값 : 이전 노드, 없으면 nullptr
+   */
+  static NodeType *PrevNode(NodeType *node) {
+    if (node->GetLeft())
+      return MaxNode(node->GetLeft());
+    NodeType *parent = node->GetParent();
+    while (parent && node == parent->GetLeft()) {
+      node = parent;
+      parent = parent->GetParent();
+    }
+    return parent;
+  }
+
+  static NodeType *MinNode(NodeType *node) {
+    while (node && node->GetLeft())
+      node = node->GetLeft();
+    return node;
+  }
+  static NodeType *MaxNode(NodeType *node) {
+    while (node && node->GetRight())
+      node = node->GetRight();
+    return node;
+  }
+
+private:
+  NodeType *node_;        // 현재 노드 (end()이면 nullptr)
+  NodeType *const *root_; // 트리의 루트 포인터 (end()에서 --할 때 사용)
+};
+
+/**
+ * 범위 스캔 커서 클래스
+ * 기능 : [lo, hi) 범위의 키를 여러 개씩 묶어서 복사해 주는 커서
+ * 설명 : 시작 위치는 lower_bound로 한 번만 찾고, 이후에는 중위 순서로 이어서 진행
+ */
+template <typename NodeType> class RangeCursor {
+public:
+  using Iterator = SetIterator<NodeType>;
+  using KeyType = typename Iterator::value_type;
+
+  RangeCursor(Iterator first, Iterator last) : cur_(first), last_(last) {}
+
+  /**
+   * 기능 : 다음 키 묶음을 가져오는 함수
+   * 동작 : 범위가 끝나거나 max_count개를 채울 때까지 키를 out에 복사
+   * 입력값 : out - 키를 저장할 배열, max_count - 최대 개수
+   * 결과값 : 복사한 키의 개수 (0이면 범위 끝)
+   */
+  int Next(KeyType *out, int max_count) {
+    int count = 0;
+    while (count < max_count && cur_ != last_) {
+      out[count++] = *cur_;
+      ++cur_;
+    }
+    return count;
+  }
+
+  bool Done() const { return cur_ == last_; }
+
+private:
+  Iterator cur_;  // 다음에 읽을 위치
+  Iterator last_; // 범위의 끝 (hi 이상인 첫 위치)
+};
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * MIT License
+
+Copyright (c) 2024 오픈소스응용프로그래밍 3분반 5팀
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Written by : 오픈소스응용프로그래밍 3분반 5팀
+Date : 2024-11-26
+*/
+
+#ifndef SHARDED_SET_H_
+#define SHARDED_SET_H_
+
+#include "avl_tree.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+/**
+ * 키 범위 샤딩 집합 클래스
+ * 기능 : 키 범위로 나눈 여러 개의 AvlTree(샤드)에 키를 나누어 저장하여 쓰기를 여러 스레드로 분산
+ * 설명 :
+ * - 샤드 i는 [bounds_[i - 1], bounds_[i]) 범위의 키를 저장하며, 샤드마다 읽기/쓰기 잠금을 따로 가짐
+ * - Rank, Select는 앞쪽 샤드의 크기와 해당 샤드 안의 랭크(rank_)를 합쳐 계산
+ * - 한 샤드가 평균의 kHotFactor배를 넘으면 Split/Union으로 모든 샤드를 같은 크기로 다시 나눔
+ *   (범위가 겹치지 않으므로 O(샤드 수 * log^2 n))
+ * - 여러 샤드를 잠글 때는 항상 번호 순서대로 잠가 교착 상태를 막음
+ */
+template <typename T> class ShardedSet {
+public:
+  static constexpr int kDefaultShardCount = 16;
+
+  explicit ShardedSet(int shard_count = kDefaultShardCount)
+      : shard_count_(std::max(shard_count, 1)),
+        shards_(new Shard[shard_count_]), size_(0) {}
+  ShardedSet(const ShardedSet &) = delete;
+  ShardedSet &operator=(const ShardedSet &) = delete;
+
+  // 기본 기능
+  bool Empty() const { return Size() == 0; }
+  int Size() const { return size_.load(std::memory_order_relaxed); }
+  int ShardCount() const { return shard_count_; }
+  bool Contains(T key) const;
+  bool Insert(T key);
+  bool Erase(T key);
+
+  // 고급 기능
+  // key의 순위 (1부터 시작), key가 없으면 0
+  int Rank(T key) const;
+  // k번째로 작은 키 (1부터 시작), 범위를 벗어나면 std::nullopt
+  std::optional<T> Select(int k) const;
+  // 샤드 경계를 다시 정해 모든 샤드의 크기를 맞춤
+  void Rebalance();
+  // index번째 샤드의 키 개수
+  int ShardSize(int index) const;
+
+private:
+  // 샤드 재분배를 시작하는 크기 비율 (평균 대비)
+  static constexpr int kHotFactor = 2;
+  // 이보다 작은 샤드는 재분배 대상에서 제외
+  static constexpr int kMinRebalanceSize = 1 << 12;
+
+  // 샤드마다 캐시 라인을 따로 사용하여 잠금 경합 시 거짓 공유를 막음
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    AvlTree<T> tree;
+  };
+
+  // key가 속한 샤드 번호 (routing_mutex_를 잡은 상태에서 호출)
+  int ShardOf(const T &key) const {
+    return static_cast<int>(std::upper_bound(bounds_.begin(), bounds_.end(),
+                                             key) -
+                            bounds_.begin());
+  }
+  void RebalanceShards();
+  bool IsHot(int size) const {
+    return size >= kMinRebalanceSize &&
+           size > kHotFactor * (Size() / shard_count_ + 1);
+  }
+
+  int shard_count_;                    // 샤드 개수
+  std::unique_ptr<Shard[]> shards_;    // 샤드 배열
+  std::vector<T> bounds_;              // 샤드 경계 (재분배 전에는 비어 있어 샤드 0만 사용)
+  mutable std::shared_mutex routing_mutex_; // 경계를 바꾸는 재분배만 배타적으로 잡음
+  std::atomic<int> size_;              // 전체 키 개수
+};
+
+template <typename T> bool ShardedSet<T>::Contains(T key) const {
+  std::shared_lock<std::shared_mutex> routing(routing_mutex_);
+  const Shard &shard = shards_[ShardOf(key)];
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.tree.Find(key).first != nullptr;
+}
+
+/**
+ * 기능 : 키 삽입 함수
+ * 동작 : 키 범위에 맞는 샤드만 잠그고 삽입한 뒤, 샤드가 너무 커졌으면 재분배
+ *        (전체 크기는 샤드 잠금을 잡은 채로 갱신하므로 재분배가 배타 잠금을 잡으면 샤드 크기의 합과 같음)
+ * 입력값 : key - 삽입할 키 값
+ * 결과값 : 새로 삽입되었는지 여부
+ */
+template <typename T> bool ShardedSet<T>::Insert(T key) {
+  int shard_size;
+  {
+    std::shared_lock<std::shared_mutex> routing(routing_mutex_);
+    Shard &shard = shards_[ShardOf(key)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    // 중복 키도 0이 아닌 값을 반환할 수 있으므로 크기 변화로 판단
+    int old_size = shard.tree.Size();
+    shard.tree.Insert(key);
+    shard_size = shard.tree.Size();
+    if (shard_size == old_size)
+      return false;
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (IsHot(shard_size)) {
+    // 다른 스레드가 먼저 재분배했을 수 있으므로 배타 잠금을 잡은 뒤 다시 확인
+    std::unique_lock<std::shared_mutex> routing(routing_mutex_);
+    for (int i = 0; i < shard_count_; i++) {
+      if (IsHot(shards_[i].tree.Size())) {
+        RebalanceShards();
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T> bool ShardedSet<T>::Erase(T key) {
+  std::shared_lock<std::shared_mutex> routing(routing_mutex_);
+  Shard &shard = shards_[ShardOf(key)];
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  if (shard.tree.Erase(key) == 0)
+    return false;
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * 기능 : 전체 집합에서 키의 순위를 계산하는 함수
+ * 동작 : 앞쪽 샤드부터 key가 속한 샤드까지 순서대로 읽기 잠금을 잡고, 앞쪽 샤드 크기와 샤드 안의 랭크를 합산
+ * 입력값 : key - 찾고자 하는 키 값
+ * 결과값 : 1부터 시작하는 순위, key가 없으면 0
+ */
+template <typename T> int ShardedSet<T>::Rank(T key) const {
+  std::shared_lock<std::shared_mutex> routing(routing_mutex_);
+  int target = ShardOf(key);
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  int before = 0;
+  for (int i = 0; i < target; i++) {
+    locks.emplace_back(shards_[i].mutex);
+    before += shards_[i].tree.Size();
+  }
+  std::shared_lock<std::shared_mutex> lock(shards_[target].mutex);
+  int rank = shards_[target].tree.Rank(key).second;
+  return rank ? before + rank : 0;
+}
+
+/**
+ * 기능 : 전체 집합에서 k번째로 작은 키를 찾는 함수
+ * 동작 : 앞쪽 샤드부터 순서대로 읽기 잠금을 잡으며 크기를 빼 나가다가, k가 속한 샤드에서 Select
+ * 입력값 : k - 1부터 시작하는 순위
+ * 결과값 : k번째 키, 범위를 벗어나면 std::nullopt
+ */
+template <typename T> std::optional<T> ShardedSet<T>::Select(int k) const {
+  std::shared_lock<std::shared_mutex> routing(routing_mutex_);
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  for (int i = 0; i < shard_count_ && k > 0; i++) {
+    locks.emplace_back(shards_[i].mutex);
+    int size = shards_[i].tree.Size();
+    if (k <= size)
+      return shards_[i].tree.Select(k)->GetKey();
+    k -= size;
+  }
+  return std::nullopt;
+}
+
+template <typename T> int ShardedSet<T>::ShardSize(int index) const {
+  std::shared_lock<std::shared_mutex> routing(routing_mutex_);
+  std::shared_lock<std::shared_mutex> lock(shards_[index].mutex);
+  return shards_[index].tree.Size();
+}
+
+template <typename T> void ShardedSet<T>::Rebalance() {
+  std::unique_lock<std::shared_mutex> routing(routing_mutex_);
+  RebalanceShards();
+}
+
+/**
+ * 기능 : 샤드 재분배 함수 (routing_mutex_를 배타적으로 잡은 상태에서 호출)
+ * 동작 : 모든 샤드를 Union으로 이어 붙인 뒤 k번째 키로 Split하여 같은 크기로 다시 나눔
+ * 입력값 : 없음
+ * 결과값 : 없음
+ */
+template <typename T> void ShardedSet<T>::RebalanceShards() {
+  // 배타 잠금 중에는 샤드가 바뀌지 않으므로 size_ 대신 샤드 크기를 직접 합산
+  int total = 0;
+  for (int i = 0; i < shard_count_; i++)
+    total += shards_[i].tree.Size();
+  if (total < shard_count_)
+    return;
+
+  // 1. 모든 샤드를 하나로 합침 (범위가 겹치지 않으므로 각 Union은 O(log^2 n))
+  AvlTree<T> all;
+  for (int i = 0; i < shard_count_; i++)
+    all.Union(shards_[i].tree);
+
+  // 2. 뒤쪽 샤드부터 경계 키로 잘라냄 (Split은 경계 키를 빼므로 오른쪽에 다시 삽입)
+  bounds_.assign(shard_count_ - 1, T());
+  for (int i = shard_count_ - 1; i > 0; i--) {
+    int rank = static_cast<int>(static_cast<long long>(total) * i /
+                                shard_count_) + 1;
+    T bound = all.Select(rank)->GetKey();
+    AvlTree<T> left;
+    all.Split(bound, left, shards_[i].tree);
+    shards_[i].tree.Insert(bound);
+    all.Union(left);
+    bounds_[i - 1] = bound;
+  }
+  shards_[0].tree.Union(all);
+}
+
+#endif
@@ -26,11 +26,31 @@ Date : 2024-11-26
 */
 
 #include "node.h"
+#include "avl_map.h"
 #include "avl_tree.h"
+#include "btree_set.h"
+#include "command_io.h"
+#include "compact_avl_tree.h"
+#include "concurrent_avl_tree.h"
+#include "driver.h"
+#include "frozen_set.h"
+#include "persistent_avl_tree.h"
+#include "sharded_set.h"
+#include <algorithm>
+#include <cstdio>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 // 1. 기본 생성자 테스트
 TEST(NodeTest, DefaultConstructorTest) {
@@ -652,6 +672,1212 @@ TEST_P(RotationFixture, TestInsertNodeAndExpectRoot) {
   ASSERT_EQ(expected_root_data, root_data);
 }
 
+// 23. 삽입된 노드가 이중 회전으로 서브트리의 루트가 될 때 반환값 확인
+TEST_F(AvlTreeSetFixture, TestInsertReturnAfterRotation) {
+  /**
+   *   삽입 전           15 삽입 후 (Left-Right)
+   *
+   *      40                  40
+   *     /  \                /  \
+   *    20  60      ==>     15  60
+   *   /                   /  \
+   *  10                  10  20
+   */
+  ASSERT_EQ(3, avltree_set_.Insert(10)); // 깊이 2 + 높이 1
+  ASSERT_EQ(3, avltree_set_.Insert(15)); // 깊이 1 + 높이 2
+  ASSERT_EQ(15, avltree_set_.GetRoot()->GetLeft()->GetKey());
+  ASSERT_EQ(5, avltree_set_.GetRoot()->GetRank());
+}
+
+// 24. 이미 존재하는 키를 삽입하면 기존 노드의 깊이와 높이의 합(루트이면 0)을 반환하고 크기가 변하지 않는지 확인
+TEST_F(AvlTreeSetFixture, TestInsertDuplicate) {
+  ASSERT_EQ(2, avltree_set_.Insert(20)); // 깊이 1 + 높이 1
+  ASSERT_EQ(0, avltree_set_.Insert(40)); // 루트
+  ASSERT_EQ(3, avltree_set_.Size());
+}
+
+// 25. 자식이 둘인 노드를 삭제해도 후임자 노드의 주소가 유지되는지 확인
+TEST_F(AvlTreeSetFixture, TestEraseKeepsSuccessorNode) {
+  /**
+   *   삭제 전            40 삭제 후
+   *
+   *     40                  50
+   *    /  \                /  \
+   *   20   60     ==>     20   60
+   *       /  \                  \
+   *      50  70                 70
+   */
+  avltree_set_.Insert(50);
+  avltree_set_.Insert(70);
+  Node<int> *successor = avltree_set_.Find(50).first;
+
+  ASSERT_EQ(3, avltree_set_.Erase(40)); // 깊이 0 + 높이 3
+  ASSERT_EQ(successor, avltree_set_.GetRoot());
+  ASSERT_EQ(successor, avltree_set_.Find(50).first);
+  EXPECT_EQ(nullptr, successor->GetParent());
+  EXPECT_EQ(4, successor->GetRank());
+  EXPECT_EQ(3, successor->GetHeight());
+}
+
+// 26. 슬랩 할당자를 사용하는 트리에서 해제된 노드가 재사용되는지 확인
+TEST(SlabAllocatorTest, ReuseErasedNode) {
+  AvlTree<int, SlabAllocator> avl_set;
+  avl_set.Reserve(100);
+  for (int key = 1; key <= 100; key++)
+    avl_set.Insert(key);
+  ASSERT_EQ(100, avl_set.Size());
+
+  Node<int> *erased_node = avl_set.Find(37).first;
+  ASSERT_NE(0, avl_set.Erase(37));
+  // 가장 최근에 해제된 슬롯이 다음 삽입에 재사용됨
+  avl_set.Insert(1000);
+  ASSERT_EQ(erased_node, avl_set.Find(1000).first);
+  ASSERT_EQ(100, avl_set.Rank(1000).second);
+}
+
+// 27. Delete 후 트리가 비고 다시 사용할 수 있는지 확인
+TEST(SlabAllocatorTest, DeleteAndReuseTree) {
+  AvlTree<int, SlabAllocator> avl_set;
+  for (int key = 0; key < 1000; key++)
+    avl_set.Insert(key);
+  avl_set.Delete();
+  ASSERT_TRUE(avl_set.Empty());
+  ASSERT_EQ(0, avl_set.Size());
+
+  ASSERT_EQ(1, avl_set.Insert(7));
+  ASSERT_EQ(1, avl_set.Size());
+}
+
+// 28. 인덱스 연결 트리가 AvlTree와 같은 결과를 반환하는지 확인
+TEST(CompactAvlTreeTest, MatchesAvlTree) {
+  AvlTree<int> avl_set;
+  CompactAvlTree<int> compact_set;
+  unsigned int seed = 12345;
+  for (int i = 0; i < 5000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 16) % 500;
+    if (i % 3 == 2)
+      ASSERT_EQ(avl_set.Erase(key), compact_set.Erase(key));
+    else
+      ASSERT_EQ(avl_set.Insert(key), compact_set.Insert(key));
+    ASSERT_EQ(avl_set.Find(key).second, compact_set.Find(key).second);
+    ASSERT_EQ(avl_set.Rank(key), compact_set.Rank(key));
+    ASSERT_EQ(avl_set.Ancestor(key), compact_set.Ancestor(key));
+    ASSERT_EQ(avl_set.Average(key), compact_set.Average(key));
+  }
+  ASSERT_EQ(avl_set.Size(), compact_set.Size());
+  ASSERT_EQ(avl_set.Height(), compact_set.Height());
+}
+
+// 29. 정렬된 범위로 구성한 트리의 높이와 랭크 확인
+TEST(BulkBuildTest, AssignSorted) {
+  std::vector<int> keys;
+  for (int key = 1; key <= 1000; key++)
+    keys.push_back(key * 2);
+
+  AvlTree<int> avl_set;
+  avl_set.Insert(7); // 기존 노드는 모두 해제됨
+  avl_set.AssignSorted(keys.begin(), keys.end());
+  ASSERT_EQ(1000, avl_set.Size());
+  ASSERT_EQ(10, avl_set.Height()); // 노드 1000개의 완전 균형 트리 높이
+  ASSERT_EQ(nullptr, avl_set.Find(7).first);
+  for (int key = 1; key <= 1000; key++)
+    ASSERT_EQ(key, avl_set.Rank(key * 2).second);
+  // 부모 포인터를 따라 루트까지 올라갈 수 있는지 확인
+  int depth = 0;
+  for (Node<int> *node = avl_set.GetMinNode(); node->GetParent();
+       node = node->GetParent())
+    depth++;
+  ASSERT_EQ(9, depth);
+
+  // 구성 이후에도 삽입과 삭제가 정상 동작
+  ASSERT_NE(0, avl_set.Insert(3));
+  ASSERT_NE(0, avl_set.Erase(1000));
+  ASSERT_EQ(1000, avl_set.Size());
+}
+
+// 30. 정렬되지 않고 중복이 있는 범위로 트리를 구성
+TEST(BulkBuildTest, ConstructFromUnsortedRange) {
+  std::vector<int> keys = {50, 10, 40, 10, 30, 20, 50, 60, 70};
+  AvlTree<int> avl_set(keys.begin(), keys.end());
+  ASSERT_EQ(7, avl_set.Size());
+  ASSERT_EQ(40, avl_set.GetRoot()->GetKey());
+  ASSERT_EQ(3, avl_set.Height());
+
+  avl_set.Assign(keys.rbegin(), keys.rend(), true);
+  ASSERT_EQ(7, avl_set.Size());
+  ASSERT_EQ(std::make_pair(3, 4), avl_set.Rank(40));
+}
+
+// 31. 정렬된 키들을 일괄 삽입한 결과가 Find 결과와 일치하는지 확인
+TEST_F(AvlTreeSetFixture, TestInsertBatch) {
+  std::vector<int> keys = {10, 20, 30, 50, 70, 80, 90};
+  std::vector<int> results = avltree_set_.InsertBatch(keys.begin(), keys.end());
+
+  ASSERT_EQ(9, avltree_set_.Size());
+  ASSERT_EQ(0, results[1]); // 20은 이미 존재
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (keys[i] != 20) {
+      EXPECT_EQ(avltree_set_.Find(keys[i]).second, results[i]);
+    }
+  }
+  ASSERT_EQ(std::make_pair(avltree_set_.Find(90).second, 9),
+            avltree_set_.Rank(90));
+}
+
+// 32. 정렬된 키들을 일괄 삭제하면 삭제 전의 깊이 + 높이를 반환하는지 확인
+TEST_F(AvlTreeSetFixture, TestEraseBatch) {
+  for (int key = 1; key <= 15; key++)
+    avltree_set_.Insert(key);
+  std::vector<int> keys = {2, 3, 5, 7, 11, 13, 25, 40};
+  std::vector<int> expected;
+  for (int key : keys)
+    expected.push_back(avltree_set_.Find(key).second);
+
+  ASSERT_EQ(expected, avltree_set_.EraseBatch(keys.begin(), keys.end()));
+  ASSERT_EQ(0, expected[6]); // 25는 존재하지 않음
+  ASSERT_EQ(11, avltree_set_.Size());
+  ASSERT_EQ(nullptr, avltree_set_.Find(40).first);
+  ASSERT_EQ(5, avltree_set_.Rank(9).second); // 1 4 6 8 9
+}
+
+// 33. Split으로 나눈 두 트리를 Join으로 다시 합치는 테스트
+TEST(SetAlgebraTest, SplitAndJoin) {
+  std::vector<int> keys = {10, 20, 30, 40, 50, 60, 70, 80, 90};
+  AvlTree<int> avl_set(keys.begin(), keys.end());
+  AvlTree<int> left, right;
+
+  ASSERT_TRUE(avl_set.Split(50, left, right));
+  ASSERT_TRUE(avl_set.Empty());
+  ASSERT_EQ(4, left.Size());
+  ASSERT_EQ(4, right.Size());
+  ASSERT_EQ(40, left.GetMaxNode()->GetKey());
+  ASSERT_EQ(60, right.GetMinNode()->GetKey());
+
+  avl_set.Join(left, 55, right);
+  ASSERT_TRUE(left.Empty());
+  ASSERT_TRUE(right.Empty());
+  ASSERT_EQ(9, avl_set.Size());
+  ASSERT_EQ(5, avl_set.Rank(55).second);
+  ASSERT_EQ(9, avl_set.Rank(90).second);
+}
+
+// 34. 합집합, 교집합, 차집합 결과의 크기와 랭크 확인
+TEST(SetAlgebraTest, UnionIntersectionDifference) {
+  std::vector<int> evens, threes;
+  for (int key = 0; key < 3000; key += 2)
+    evens.push_back(key);
+  for (int key = 0; key < 3000; key += 3)
+    threes.push_back(key);
+
+  AvlTree<int> union_set(evens.begin(), evens.end());
+  AvlTree<int> other(threes.begin(), threes.end());
+  union_set.Union(other);
+  ASSERT_TRUE(other.Empty());
+  ASSERT_EQ(2000, union_set.Size()); // 1500 + 1000 - 500
+  ASSERT_EQ(4, union_set.Rank(4).second); // 0 2 3 4
+
+  AvlTree<int> intersection_set(evens.begin(), evens.end());
+  other.AssignSorted(threes.begin(), threes.end());
+  intersection_set.Intersection(other);
+  ASSERT_EQ(500, intersection_set.Size());
+  ASSERT_EQ(3, intersection_set.Rank(12).second); // 0 6 12
+
+  AvlTree<int> difference_set(evens.begin(), evens.end());
+  other.AssignSorted(threes.begin(), threes.end());
+  difference_set.Difference(other);
+  ASSERT_EQ(1000, difference_set.Size());
+  ASSERT_EQ(nullptr, difference_set.Find(6).first);
+  ASSERT_EQ(4, difference_set.Rank(10).second); // 2 4 8 10
+}
+
+// 35. [lo, hi) 범위 삭제 후 크기와 랭크 확인
+TEST(RangeTest, EraseRange) {
+  std::vector<int> keys;
+  for (int key = 0; key < 100; key++)
+    keys.push_back(key);
+  AvlTree<int> avl_set(keys.begin(), keys.end());
+
+  ASSERT_EQ(30, avl_set.EraseRange(20, 50));
+  ASSERT_EQ(70, avl_set.Size());
+  ASSERT_EQ(nullptr, avl_set.Find(20).first);
+  ASSERT_NE(nullptr, avl_set.Find(50).first);
+  ASSERT_EQ(21, avl_set.Rank(50).second);
+  ASSERT_EQ(0, avl_set.EraseRange(20, 50)); // 이미 비어 있는 범위
+  ASSERT_EQ(0, avl_set.EraseRange(60, 60)); // 빈 범위
+}
+
+// 36. [lo, hi) 범위를 다른 트리로 추출
+TEST(RangeTest, ExtractRange) {
+  std::vector<int> keys;
+  for (int key = 0; key < 100; key += 5)
+    keys.push_back(key);
+  AvlTree<int> avl_set(keys.begin(), keys.end());
+  AvlTree<int> range_set;
+
+  ASSERT_EQ(4, avl_set.ExtractRange(12, 31, range_set)); // 15 20 25 30
+  ASSERT_EQ(16, avl_set.Size());
+  ASSERT_EQ(4, range_set.Size());
+  ASSERT_EQ(15, range_set.GetMinNode()->GetKey());
+  ASSERT_EQ(30, range_set.GetMaxNode()->GetKey());
+  ASSERT_EQ(4, avl_set.Rank(35).second); // 0 5 10 35
+}
+
+// 37. k번째 노드와 분위수 노드 확인
+TEST_F(AvlTreeSetFixture, TestSelectAndQuantile) {
+  for (int key = 10; key <= 100; key += 10)
+    avltree_set_.Insert(key); // 10 20 ... 100 (20, 40, 60은 이미 존재)
+
+  ASSERT_EQ(10, avltree_set_.Select(1)->GetKey());
+  ASSERT_EQ(70, avltree_set_.Select(7)->GetKey());
+  ASSERT_EQ(nullptr, avltree_set_.Select(0));
+  ASSERT_EQ(nullptr, avltree_set_.Select(11));
+  for (int k = 1; k <= avltree_set_.Size(); k++)
+    ASSERT_EQ(k, avltree_set_.Rank(avltree_set_.Select(k)->GetKey()).second);
+
+  ASSERT_EQ(10, avltree_set_.Quantile(0.0)->GetKey());
+  ASSERT_EQ(50, avltree_set_.Quantile(0.5)->GetKey());
+  ASSERT_EQ(90, avltree_set_.Quantile(0.9)->GetKey());
+  ASSERT_EQ(100, avltree_set_.Quantile(1.0)->GetKey());
+}
+
+// 38. 존재하지 않는 키의 순위와 범위 내 키 개수 확인
+TEST_F(AvlTreeSetFixture, TestRankOfBoundAndCountRange) {
+  // 20 40 60
+  ASSERT_EQ(0, avltree_set_.RankOfBound(5));
+  ASSERT_EQ(1, avltree_set_.RankOfBound(25));
+  ASSERT_EQ(1, avltree_set_.RankOfBound(40)); // 존재하는 키는 Rank - 1
+  ASSERT_EQ(3, avltree_set_.RankOfBound(99));
+
+  ASSERT_EQ(2, avltree_set_.CountRange(20, 60));
+  ASSERT_EQ(3, avltree_set_.CountRange(0, 61));
+  ASSERT_EQ(0, avltree_set_.CountRange(41, 59));
+  ASSERT_EQ(0, avltree_set_.CountRange(60, 20));
+}
+
+// 39. 서브트리 합 집계값과 범위 합 질의 확인
+TEST(AugmentTest, SubtreeSumAndRangeSum) {
+  AvlTree<int, NodeAllocator, SumAugment<int>> avl_set;
+  for (int key = 1; key <= 100; key++)
+    avl_set.Insert(key);
+  avl_set.Erase(50);
+
+  ASSERT_EQ(5050 - 50, avl_set.GetRoot()->GetAggregate());
+  ASSERT_EQ(55, *avl_set.RangeAggregate(1, 11));    // 1 ~ 10
+  ASSERT_EQ(49 + 51, *avl_set.RangeAggregate(49, 52)); // 50은 삭제됨
+  ASSERT_FALSE(avl_set.RangeAggregate(50, 51).has_value());
+}
+
+// 40. 최솟값/최댓값 집계값으로 계산한 Average가 기존 결과와 같은지 확인
+TEST(AugmentTest, MinMaxAverage) {
+  AvlTree<int> plain_set;
+  AvlTree<int, NodeAllocator, MinMaxAugment<int>> minmax_set;
+  for (int key : {50, 30, 80, 60, 130, 120, 201, 32, 98, 99, 11, 401}) {
+    plain_set.Insert(key);
+    minmax_set.Insert(key);
+  }
+  for (int key : {50, 30, 80, 60, 130, 120, 201, 32, 98, 99, 11, 401})
+    ASSERT_EQ(plain_set.Average(key), minmax_set.Average(key));
+
+  auto range = minmax_set.RangeAggregate(31, 100);
+  ASSERT_EQ(32, range->first);
+  ASSERT_EQ(99, range->second);
+}
+
+// 41. 반복자로 정방향/역방향 순회하고 경계 위치 확인
+TEST(IteratorTest, TraverseAndBounds) {
+  AvlTree<int> set;
+  std::vector<int> keys = {50, 30, 80, 60, 130, 120, 201, 32, 98, 99, 11, 401};
+  for (int key : keys)
+    set.Insert(key);
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<int> forward(set.begin(), set.end());
+  ASSERT_EQ(keys, forward);
+  std::vector<int> backward;
+  for (auto it = set.end(); it != set.begin();)
+    backward.push_back(*--it);
+  ASSERT_EQ(std::vector<int>(keys.rbegin(), keys.rend()), backward);
+
+  ASSERT_EQ(60, *set.lower_bound(60));
+  ASSERT_EQ(80, *set.upper_bound(60));
+  ASSERT_EQ(60, *set.lower_bound(55));
+  ASSERT_TRUE(set.lower_bound(402) == set.end());
+  auto range = set.equal_range(98);
+  ASSERT_EQ(1, std::distance(range.first, range.second));
+  ASSERT_EQ(99, set.Successor(98)->GetKey());
+  ASSERT_EQ(80, set.Predecessor(97)->GetKey());
+  ASSERT_EQ(nullptr, set.Predecessor(11));
+  ASSERT_EQ(nullptr, set.Successor(401));
+}
+
+// 42. 범위 스캔 커서로 키를 묶음 단위로 읽기
+TEST(IteratorTest, RangeCursor) {
+  AvlTree<int> set;
+  for (int key = 0; key < 100; key++)
+    set.Insert(key * 2);
+  auto cursor = set.Scan(15, 41);
+  std::vector<int> scanned;
+  int buffer[4];
+  for (int count; (count = cursor.Next(buffer, 4)) > 0;) {
+    ASSERT_LE(count, 4);
+    scanned.insert(scanned.end(), buffer, buffer + count);
+  }
+  ASSERT_TRUE(cursor.Done());
+  ASSERT_EQ(13u, scanned.size());
+  ASSERT_EQ(16, scanned.front());
+  ASSERT_EQ(40, scanned.back());
+  ASSERT_EQ(0, set.Scan(41, 15).Next(buffer, 4));
+}
+
+// 43. end() 힌트로 증가하는 키를 삽입한 결과가 일반 삽입과 같은지 확인
+TEST(FingerSearchTest, HintedInsert) {
+  AvlTree<int> plain_set, hinted_set;
+  for (int key = 0; key < 1000; key++) {
+    int expected = plain_set.Insert(key * 3);
+    ASSERT_EQ(expected, hinted_set.Insert(hinted_set.end(), key * 3));
+  }
+  // 힌트와 멀리 떨어진 키, 이미 존재하는 키
+  ASSERT_EQ(plain_set.Insert(1), hinted_set.Insert(hinted_set.end(), 1));
+  ASSERT_EQ(plain_set.Insert(300),
+            hinted_set.Insert(hinted_set.lower_bound(2000), 300));
+  ASSERT_EQ(plain_set.Insert(1502),
+            hinted_set.Insert(hinted_set.lower_bound(1500), 1502));
+  for (int key = 0; key < 3000; key++)
+    ASSERT_EQ(plain_set.Find(key).second, hinted_set.Find(key).second);
+  ASSERT_EQ(plain_set.Height(), hinted_set.Height());
+  ASSERT_EQ(plain_set.Rank(1502), hinted_set.Rank(1502));
+}
+
+// 44. 여러 위치에서 시작한 핑거 탐색
+TEST(FingerSearchTest, FindFromHint) {
+  AvlTree<int> set;
+  for (int key = 0; key < 500; key++)
+    set.Insert(key * 2);
+  for (int from : {0, 100, 499, 998}) {
+    auto hint = set.lower_bound(from);
+    for (int key = 0; key < 1000; key++) {
+      auto it = set.Find(hint, key);
+      if (key % 2)
+        ASSERT_TRUE(it == set.end());
+      else
+        ASSERT_EQ(key, *it);
+    }
+  }
+  ASSERT_TRUE(set.Find(set.end(), -1) == set.end());
+}
+
+// 45. 영속 트리의 삽입/삭제 결과가 AvlTree와 같은지 확인
+TEST(PersistentAvlTreeTest, SameResultAsAvlTree) {
+  AvlTree<int> set;
+  PersistentAvlTree<int> persistent;
+  for (int key : {50, 30, 80, 60, 130, 120, 201, 32, 98, 99, 11, 401})
+    ASSERT_EQ(set.Insert(key), persistent.Insert(key));
+  for (int key : {60, 50, 401})
+    ASSERT_EQ(set.Insert(key), persistent.Insert(key));
+  for (int key : {30, 120, 7, 50})
+    ASSERT_EQ(set.Erase(key), persistent.Erase(key));
+  for (int key : {60, 130, 201, 32, 98, 99, 11, 401}) {
+    ASSERT_EQ(set.Find(key).second, persistent.Find(key).second);
+    ASSERT_EQ(set.Rank(key), persistent.Rank(key));
+  }
+  ASSERT_EQ(set.Size(), persistent.Size());
+  ASSERT_EQ(set.Height(), persistent.Height());
+}
+
+// 46. 스냅샷 이후의 수정이 스냅샷에 보이지 않는지 확인
+TEST(PersistentAvlTreeTest, SnapshotIsImmutable) {
+  PersistentAvlTree<int> tree;
+  for (int key = 0; key < 100; key++)
+    tree.Insert(key);
+  PersistentAvlTree<int> snapshot = tree.Snapshot();
+  for (int key = 0; key < 100; key += 2)
+    tree.Erase(key);
+  tree.Insert(1000);
+
+  ASSERT_EQ(100, snapshot.Size());
+  ASSERT_EQ(51, tree.Size());
+  ASSERT_NE(nullptr, snapshot.Find(50).first);
+  ASSERT_EQ(nullptr, tree.Find(50).first);
+  ASSERT_EQ(nullptr, snapshot.Find(1000).first);
+
+  std::vector<int> keys;
+  snapshot.ForEach(10, 15, [&keys](int key) { keys.push_back(key); });
+  ASSERT_EQ(std::vector<int>({10, 11, 12, 13, 14}), keys);
+  keys.clear();
+  tree.ForEach(10, 15, [&keys](int key) { keys.push_back(key); });
+  ASSERT_EQ(std::vector<int>({11, 13}), keys);
+}
+
+// 47. 동시성 트리의 단일 스레드 결과가 AvlTree와 같은지 확인
+TEST(ConcurrentAvlTreeTest, SameResultAsAvlTree) {
+  AvlTree<int> set;
+  ConcurrentAvlTree<int> concurrent;
+  for (int key : {50, 30, 80, 60, 130, 120, 201, 32, 98, 99, 11, 401})
+    ASSERT_EQ(set.Insert(key), concurrent.Insert(key));
+  for (int key : {60, 50, 401})
+    ASSERT_EQ(set.Insert(key), concurrent.Insert(key));
+  for (int key : {30, 120, 7, 50})
+    ASSERT_EQ(set.Erase(key), concurrent.Erase(key));
+  for (int key : {60, 130, 201, 32, 98, 99, 11, 401, 7}) {
+    ASSERT_EQ(set.Find(key).second, concurrent.Find(key).second);
+    ASSERT_EQ(set.Rank(key), concurrent.Rank(key));
+    ASSERT_EQ(set.Ancestor(key), concurrent.Ancestor(key));
+  }
+  ASSERT_EQ(set.Size(), concurrent.Size());
+  ASSERT_EQ(set.Height(), concurrent.Height());
+}
+
+// 48. 쓰기 스레드가 다른 키를 삽입/삭제하는 동안 읽기 스레드가 기존 키를 항상 찾는지 확인
+TEST(ConcurrentAvlTreeTest, ReadersDuringWrites) {
+  ConcurrentAvlTree<int> tree;
+  for (int key = 0; key < 2000; key += 2)
+    tree.Insert(key);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> missing(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; t++) {
+    readers.emplace_back([&tree, &done, &missing, t] {
+      for (int key = t * 2; !done.load(); key = (key + 14) % 2000) {
+        if (!tree.Find(key).first || tree.Rank(key).second <= key / 2)
+          missing++;
+      }
+    });
+  }
+  for (int round = 0; round < 20; round++) {
+    for (int key = 1; key < 2000; key += 2)
+      tree.Insert(key);
+    for (int key = 1; key < 2000; key += 2)
+      tree.Erase(key);
+  }
+  done = true;
+  for (std::thread &reader : readers)
+    reader.join();
+
+  ASSERT_EQ(0, missing.load());
+  ASSERT_EQ(1000, tree.Size());
+}
+
+// 49. 샤드 재분배 후에도 전체 순위와 k번째 키가 유지되는지 확인
+TEST(ShardedSetTest, RankAndSelectAcrossShards) {
+  ShardedSet<int> set(4);
+  for (int key = 1; key <= 1000; key++)
+    ASSERT_TRUE(set.Insert(key * 10));
+  ASSERT_FALSE(set.Insert(500));
+  set.Rebalance();
+  for (int i = 0; i < set.ShardCount(); i++)
+    ASSERT_EQ(250, set.ShardSize(i));
+
+  ASSERT_TRUE(set.Erase(10));
+  ASSERT_FALSE(set.Erase(15));
+  ASSERT_EQ(999, set.Size());
+  ASSERT_EQ(1, set.Rank(20));
+  ASSERT_EQ(500, set.Rank(5010));
+  ASSERT_EQ(0, set.Rank(5015));
+  ASSERT_EQ(5010, *set.Select(500));
+  ASSERT_EQ(10000, *set.Select(999));
+  ASSERT_FALSE(set.Select(1000).has_value());
+  ASSERT_TRUE(set.Contains(7500));
+}
+
+// 50. 증가하는 키를 여러 스레드에서 삽입할 때 자동 재분배로 한 샤드에 몰리지 않는지 확인
+TEST(ShardedSetTest, ConcurrentInsertRebalances) {
+  ShardedSet<int> set(4);
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; t++) {
+    writers.emplace_back([&set, t] {
+      for (int i = 0; i < 20000; i++)
+        set.Insert(i * 4 + t);
+    });
+  }
+  for (std::thread &writer : writers)
+    writer.join();
+
+  ASSERT_EQ(80000, set.Size());
+  for (int i = 0; i < set.ShardCount(); i++)
+    ASSERT_LT(set.ShardSize(i), 40000);
+  ASSERT_EQ(40001, set.Rank(40000));
+}
+
+// 51. 병렬 일괄 질의 결과가 입력 순서대로 단일 질의 결과와 같은지 확인
+TEST(ParallelQueryTest, SameResultAsSingleQuery) {
+  AvlTree<int> set;
+  for (int key = 0; key < 5000; key++)
+    set.Insert((key * 7919) % 10007);
+  std::vector<int> keys;
+  for (int key = 0; key < 10000; key++)
+    keys.push_back((key * 31) % 10050);
+
+  std::vector<int> finds(keys.size()), averages(keys.size());
+  std::vector<std::pair<int, int>> ranks(keys.size()), ancestors(keys.size());
+  set.ParallelFind(keys.data(), keys.size(), finds.data(), 4);
+  set.ParallelRank(keys.data(), keys.size(), ranks.data(), 4);
+  set.ParallelAncestor(keys.data(), keys.size(), ancestors.data(), 4);
+  set.ParallelAverage(keys.data(), keys.size(), averages.data(), 4);
+  for (size_t i = 0; i < keys.size(); i++) {
+    ASSERT_EQ(set.Find(keys[i]).second, finds[i]);
+    ASSERT_EQ(set.Rank(keys[i]), ranks[i]);
+    ASSERT_EQ(set.Ancestor(keys[i]), ancestors[i]);
+    ASSERT_EQ(set.Average(keys[i]), averages[i]);
+  }
+}
+
+// 52. 그룹 프리페치 일괄 탐색 결과가 단일 질의 결과와 같은지 확인
+TEST(ParallelQueryTest, FindBatchAndRankBatch) {
+  AvlTree<int> set;
+  for (int key = 0; key < 3000; key++)
+    set.Insert((key * 7919) % 6007);
+  std::vector<int> keys;
+  for (int key = -10; key < 6100; key += 3)
+    keys.push_back(key);
+
+  std::vector<int> finds(keys.size());
+  std::vector<std::pair<int, int>> ranks(keys.size());
+  set.FindBatch(keys.data(), keys.size(), finds.data());
+  set.RankBatch(keys.data(), keys.size(), ranks.data());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ASSERT_EQ(set.Find(keys[i]).second, finds[i]);
+    ASSERT_EQ(set.Rank(keys[i]), ranks[i]);
+  }
+}
+
+// 53. 고정 집합의 질의 결과가 원래 트리와 같은지 확인
+TEST(FrozenSetTest, SameResultAsTree) {
+  AvlTree<int> set;
+  for (int key : {50, 30, 80, 60, 130, 120, 201, 32, 98, 99, 11, 401})
+    set.Insert(key);
+  set.Erase(120);
+  FrozenSet<int> frozen(set);
+
+  ASSERT_EQ(set.Size(), frozen.Size());
+  ASSERT_EQ(set.Height(), frozen.Height());
+  for (int key = 0; key < 410; key++) {
+    ASSERT_EQ(set.Find(key).second, frozen.Find(key).second);
+    ASSERT_EQ(set.Rank(key), frozen.Rank(key));
+    ASSERT_EQ(set.RankOfBound(key), frozen.RankOfBound(key));
+  }
+  ASSERT_EQ(60, *frozen.lower_bound(55));
+  ASSERT_EQ(nullptr, frozen.lower_bound(402));
+  for (int k = 1; k <= set.Size(); k++)
+    ASSERT_EQ(set.Select(k)->GetKey(), *frozen.Select(k));
+  ASSERT_EQ(nullptr, frozen.Select(0));
+  ASSERT_TRUE(FrozenSet<int>(AvlTree<int>()).Empty());
+}
+
+// 54. B-tree 집합의 삽입/삭제 후 순위와 k번째 키가 AvlTree와 같은지 확인
+TEST(BTreeSetTest, SameOrderStatisticsAsAvlTree) {
+  AvlTree<int> set;
+  BTreeSet<int> btree;
+  for (int key = 0; key < 3000; key++) {
+    int value = (key * 7919) % 6007;
+    ASSERT_EQ(set.Insert(value) != 0, btree.Insert(value) != 0);
+  }
+  // 이미 있는 키는 크기가 변하지 않고 리프의 깊이 + 높이(트리 높이)를 반환
+  ASSERT_EQ(btree.Height(), btree.Insert(7919 % 6007));
+  ASSERT_EQ(3000, btree.Size());
+  BTreeSet<int> single;
+  ASSERT_EQ(1, single.Insert(5));
+  ASSERT_EQ(0, single.Insert(5)); // 루트 노드의 키
+  for (int key = 0; key < 6007; key += 3)
+    ASSERT_EQ(set.Erase(key) != 0, btree.Erase(key) != 0);
+
+  ASSERT_EQ(set.Size(), btree.Size());
+  ASSERT_LT(btree.Height(), set.Height());
+  for (int key = 0; key < 6007; key++) {
+    ASSERT_EQ(set.Rank(key).second, btree.Rank(key).second);
+    // 모든 리프의 깊이가 같으므로 깊이 + 높이는 트리 높이
+    ASSERT_EQ(set.Find(key).first ? btree.Height() : 0,
+              btree.Find(key).second);
+  }
+  for (int k = 0; k <= set.Size() + 1; k++) {
+    if (set.Select(k))
+      ASSERT_EQ(set.Select(k)->GetKey(), *btree.Select(k));
+    else
+      ASSERT_EQ(nullptr, btree.Select(k));
+  }
+}
+
+// 55. 문자열 키를 string_view로 탐색하고 rvalue 키와 Emplace로 삽입
+TEST(CompareTest, StringKeysWithHeterogeneousLookup) {
+  AvlTree<std::string> set;
+  std::string key = "banana";
+  set.Insert(key);
+  set.Insert(std::string("apple"));
+  set.Emplace(3, 'c');
+  ASSERT_EQ(2, set.Emplace("apple")); // 이미 있는 키 (깊이 1 + 높이 1)
+  ASSERT_EQ(3, set.Size());
+  ASSERT_EQ("banana", key);
+
+  std::string_view view = "banana";
+  ASSERT_TRUE(set.Find(view).first);
+  ASSERT_FALSE(set.Find(std::string_view("cherry")).first);
+  ASSERT_EQ(2, set.Rank(view).second);
+  ASSERT_EQ("ccc", *set.lower_bound(std::string_view("c")));
+  ASSERT_EQ(1, set.RankOfBound("b"));
+  ASSERT_NE(0, set.Erase("apple"));
+  ASSERT_EQ(2, set.Size());
+}
+
+// 56. 사용자 비교 정책으로 내림차순 트리를 구성
+struct DescendingCompare {
+  int operator()(int a, int b) const { return a > b ? -1 : (a < b ? 1 : 0); }
+};
+
+TEST(CompareTest, CustomComparatorOrder) {
+  AvlTree<int, NodeAllocator, NoAugment, DescendingCompare> set;
+  for (int key : {50, 30, 80, 60, 130})
+    set.Insert(key);
+  std::vector<int> keys(set.begin(), set.end());
+  ASSERT_EQ((std::vector<int>{130, 80, 60, 50, 30}), keys);
+  ASSERT_EQ(1, set.Rank(130).second);
+  ASSERT_EQ(3, set.CountRange(100, 40));
+  ASSERT_EQ(3, set.EraseRange(100, 40));
+  ASSERT_EQ(130, set.Select(1)->GetKey());
+
+  std::vector<int> input = {5, 9, 1, 9, 3};
+  AvlTree<int, NodeAllocator, NoAugment, DescendingCompare> built(input.begin(),
+                                                                  input.end());
+  ASSERT_EQ((std::vector<int>{9, 5, 3, 1}),
+            std::vector<int>(built.begin(), built.end()));
+}
+
+// 57. 맵의 값을 제자리에서 갱신하고 키 순서로 순위와 k번째 항목을 구함
+TEST(AvlMapTest, InPlaceUpdateAndOrderStatistics) {
+  AvlMap<int, long long> map;
+  for (int i = 0; i < 1000; i++)
+    map[(i * 37) % 101] += i;
+  ASSERT_EQ(101, map.Size());
+
+  long long total = 0;
+  for (const auto &entry : map)
+    total += entry.second;
+  ASSERT_EQ(999LL * 1000 / 2, total);
+
+  ASSERT_FALSE(map.try_emplace(5, 0).second);
+  ASSERT_TRUE(map.try_emplace(500, 7).second);
+  ASSERT_EQ(7, *map.FindValue(500));
+  ASSERT_EQ(nullptr, map.FindValue(501));
+  ASSERT_EQ(6, map.Rank(5).second);
+  ASSERT_EQ(100, map.Select(101)->GetKey().first);
+  ASSERT_NE(0, map.Erase(500));
+  ASSERT_EQ(0, map.Erase(500));
+}
+
+// 58. extract와 insert로 노드를 재할당 없이 다른 맵으로 옮김
+TEST(AvlMapTest, NodeHandleMovesEntry) {
+  AvlMap<std::string, int> from, to;
+  for (int i = 0; i < 50; i++)
+    from[std::to_string(i)] = i;
+  to["7"] = -1;
+
+  auto *address = from.Find(std::string_view("12")).first;
+  auto handle = from.extract(std::string_view("12"));
+  ASSERT_FALSE(handle.empty());
+  ASSERT_EQ(49, from.Size());
+  ASSERT_FALSE(from.FindValue("12"));
+  ASSERT_TRUE(from.extract("12").empty());
+
+  auto result = to.insert(std::move(handle));
+  ASSERT_TRUE(result.second);
+  ASSERT_TRUE(handle.empty());
+  ASSERT_EQ(address, to.Find("12").first);
+  ASSERT_EQ(12, result.first->second);
+
+  // 같은 키가 있으면 핸들이 그대로 남음
+  auto duplicate = from.extract("7");
+  ASSERT_FALSE(to.insert(std::move(duplicate)).second);
+  ASSERT_EQ(7, duplicate.value().second);
+  ASSERT_EQ(-1, to["7"]);
+  ASSERT_EQ(2, to.Size());
+}
+
+// 59. 가상 함수 없는 트리와 Set 인터페이스 어댑터의 결과가 같은지 확인
+TEST(SetAdapterTest, SameResultAsTree) {
+  static_assert(!std::is_polymorphic<AvlTree<int>>::value,
+                "AvlTree는 가상 함수 없이 정적으로 호출되어야 합니다");
+  AvlTree<int> tree;
+  std::unique_ptr<Set<int>> set = std::make_unique<SetAdapter<AvlTree<int>>>();
+  ASSERT_TRUE(set->Empty());
+  for (int key : {50, 30, 80, 60, 130, 120, 201, 32, 98, 99, 11, 401})
+    ASSERT_EQ(tree.Insert(key), set->Insert(key));
+  ASSERT_EQ(tree.Erase(120), set->Erase(120));
+  ASSERT_EQ(tree.Erase(121), set->Erase(121));
+
+  ASSERT_EQ(tree.Size(), set->Size());
+  ASSERT_EQ(tree.Height(), set->Height());
+  for (int key = 0; key < 410; key++) {
+    ASSERT_EQ(tree.Find(key).first != nullptr, set->Find(key).first);
+    ASSERT_EQ(tree.Find(key).second, set->Find(key).second);
+    ASSERT_EQ(tree.Rank(key), set->Rank(key));
+    ASSERT_EQ(tree.Ancestor(key), set->Ancestor(key));
+    ASSERT_EQ(tree.Average(key), set->Average(key));
+  }
+}
+
+// 60. 명령어 토큰과 정수 토큰을 빠른 입력 방식으로 변환
+TEST(CommandIoTest, ParseCommandAndInt) {
+  const std::pair<const char *, Command> commands[] = {
+      {"Insert", Command::kInsert}, {"Empty", Command::kEmpty},
+      {"Find", Command::kFind},     {"Size", Command::kSize},
+      {"Rank", Command::kRank},     {"Erase", Command::kErase},
+      {"Height", Command::kHeight}, {"Ancestor", Command::kAncestor},
+      {"Average", Command::kAverage}};
+  for (const auto &command : commands)
+    ASSERT_EQ(command.second, ParseCommand(command.first));
+  for (const char *word : {"", "I", "Inserts", "Emp", "Erasd", "Averag", "find"})
+    ASSERT_EQ(Command::kUnknown, ParseCommand(word));
+  ASSERT_FALSE(HasOperand(Command::kSize));
+  ASSERT_TRUE(HasOperand(Command::kAverage));
+
+  ASSERT_EQ(0, InputBuffer::ParseInt("0"));
+  ASSERT_EQ(2147483647, InputBuffer::ParseInt("2147483647"));
+  ASSERT_EQ(-2147483647 - 1, InputBuffer::ParseInt("-2147483648"));
+  ASSERT_EQ(42, InputBuffer::ParseInt("+42"));
+}
+
+// 61. 이진 형식의 명령어 이름, 결과 개수, 리틀 엔디언 변환 확인
+TEST(CommandIoTest, BinaryFormatHelpers) {
+  for (int op = 0; op < static_cast<int>(Command::kUnknown); op++) {
+    Command command = static_cast<Command>(op);
+    ASSERT_EQ(command, ParseCommand(CommandName(command)));
+  }
+  ASSERT_EQ("", CommandName(Command::kUnknown));
+  ASSERT_EQ(2, ResultWidth(Command::kRank));
+  ASSERT_EQ(2, ResultWidth(Command::kAncestor));
+  ASSERT_EQ(1, ResultWidth(Command::kEmpty));
+  ASSERT_EQ(0, ResultWidth(static_cast<Command>(200)));
+
+  const unsigned char bytes[] = {0x78, 0x56, 0x34, 0x12, 0xff, 0xff, 0xff, 0xff};
+  ASSERT_EQ(0x12345678u, InputBuffer::DecodeUint32(bytes));
+  ASSERT_EQ(-1, static_cast<int>(InputBuffer::DecodeUint32(bytes + 4)));
+}
+
+// 62. 병렬로 나뉘는 크기(kForkThreshold 이상)의 집합 연산 결과를 std 알고리즘과 비교
+TEST(SetAlgebraTest, LargeTreesReachForkPath) {
+  std::vector<int> left_keys, right_keys;
+  for (int key = 0; key < 60000; key++) {
+    left_keys.push_back(static_cast<int>(key * 7919LL % 90001));
+    right_keys.push_back(static_cast<int>(key * 104729LL % 90001) + 30000);
+  }
+  std::sort(left_keys.begin(), left_keys.end());
+  std::sort(right_keys.begin(), right_keys.end());
+  left_keys.erase(std::unique(left_keys.begin(), left_keys.end()),
+                  left_keys.end());
+  right_keys.erase(std::unique(right_keys.begin(), right_keys.end()),
+                   right_keys.end());
+
+  std::vector<int> expected[3];
+  std::set_union(left_keys.begin(), left_keys.end(), right_keys.begin(),
+                 right_keys.end(), std::back_inserter(expected[0]));
+  std::set_intersection(left_keys.begin(), left_keys.end(), right_keys.begin(),
+                        right_keys.end(), std::back_inserter(expected[1]));
+  std::set_difference(left_keys.begin(), left_keys.end(), right_keys.begin(),
+                      right_keys.end(), std::back_inserter(expected[2]));
+
+  for (int operation = 0; operation < 3; operation++) {
+    AvlTree<int> tree;
+    {
+      // other는 연산 후 먼저 소멸해도 tree에 영향이 없어야 함
+      AvlTree<int> other;
+      tree.AssignSorted(left_keys.begin(), left_keys.end());
+      other.AssignSorted(right_keys.begin(), right_keys.end());
+      if (operation == 0)
+        tree.Union(other);
+      else if (operation == 1)
+        tree.Intersection(other);
+      else
+        tree.Difference(other);
+      ASSERT_TRUE(other.Empty());
+    }
+    ASSERT_EQ(expected[operation], std::vector<int>(tree.begin(), tree.end()));
+    ASSERT_EQ(static_cast<int>(expected[operation].size()), tree.Size());
+    for (size_t i = 0; i < expected[operation].size(); i += 997)
+      ASSERT_EQ(static_cast<int>(i) + 1, tree.Rank(expected[operation][i]).second);
+  }
+}
+
+// 63. 빈 트리에서 일괄 질의가 모든 결과를 0으로 채우는지 확인
+TEST(ParallelQueryTest, EmptyTreeBatchResults) {
+  AvlTree<int> set;
+  std::vector<int> keys(100);
+  for (int i = 0; i < 100; i++)
+    keys[i] = i;
+
+  std::vector<int> find_results(keys.size(), -7);
+  set.FindBatch(keys.data(), keys.size(), find_results.data());
+  ASSERT_EQ(std::vector<int>(keys.size(), 0), find_results);
+
+  std::vector<std::pair<int, int>> rank_results(keys.size(), {-7, -7});
+  set.RankBatch(keys.data(), keys.size(), rank_results.data());
+  for (const auto &result : rank_results)
+    ASSERT_EQ(set.Rank(0), result);
+
+  std::vector<int> parallel_results(keys.size(), -7);
+  set.ParallelFind(keys.data(), keys.size(), parallel_results.data(), 4);
+  ASSERT_EQ(std::vector<int>(keys.size(), 0), parallel_results);
+}
+
+// 64. 여러 쓰기 스레드가 다른 서브트리와 같은 키를 동시에 삽입/삭제해도 크기, 랭크, 높이가 맞는지 확인
+TEST(ConcurrentAvlTreeTest, ConcurrentWriters) {
+  ConcurrentAvlTree<int> tree;
+  for (int key = 0; key < 4000; key += 2)
+    tree.Insert(key);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> missing(0);
+  std::thread reader([&tree, &done, &missing] {
+    for (int key = 0; !done.load(); key = (key + 34) % 4000) {
+      if (!tree.Find(key).first || tree.Rank(key).second <= key / 2)
+        missing++;
+    }
+  });
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; t++) {
+    writers.emplace_back([&tree, t] {
+      for (int round = 0; round < 10; round++) {
+        // 스레드마다 다른 홀수 키와 모든 스레드가 같이 쓰는 키
+        for (int key = 1 + t * 2; key < 4000; key += 8)
+          tree.Insert(key);
+        for (int key = 5001; key < 6000; key += 2)
+          tree.Insert(key);
+        for (int key = 1 + t * 2; key < 4000; key += 8)
+          if (key % 3 == 0)
+            tree.Erase(key);
+      }
+    });
+  }
+  for (std::thread &writer : writers)
+    writer.join();
+  done = true;
+  reader.join();
+  ASSERT_EQ(0, missing.load());
+
+  std::set<int> expected;
+  for (int key = 0; key < 4000; key++)
+    if (key % 2 == 0 || key % 3 != 0)
+      expected.insert(key);
+  for (int key = 5001; key < 6000; key += 2)
+    expected.insert(key);
+  ASSERT_EQ(static_cast<int>(expected.size()), tree.Size());
+  int rank = 0;
+  for (int key = 0; key < 6000; key++) {
+    bool present = expected.count(key) > 0;
+    ASSERT_EQ(present, tree.Find(key).first);
+    if (present) {
+      ASSERT_EQ(++rank, tree.Rank(key).second);
+    }
+  }
+  // 노드가 4167개인 AVL 트리의 높이는 17 이하
+  ASSERT_LE(tree.Height(), 17);
+}
+
+// 65. ParallelFor를 여러 번 호출해도 같은 작업 스레드를 재사용하고 모든 작업을 한 번씩만 처리하는지 확인
+TEST(ParallelForTest, ReusesPoolThreads) {
+  std::mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  std::vector<std::atomic<int>> visits(10000);
+  for (int call = 0; call < 50; call++) {
+    ParallelFor(
+        visits.size(),
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; i++)
+            visits[i]++;
+          // 작업 안에서 다시 호출하면 그 스레드에서 바로 실행
+          int nested = 0;
+          ParallelFor(
+              3, [&](size_t b, size_t e) { nested += static_cast<int>(e - b); },
+              4, 1);
+          ASSERT_EQ(3, nested);
+          std::lock_guard<std::mutex> lock(mutex);
+          thread_ids.insert(std::this_thread::get_id());
+        },
+        4, 64);
+  }
+  for (std::atomic<int> &count : visits)
+    ASSERT_EQ(50, count.load());
+  // 호출한 스레드와 작업 스레드 3개
+  ASSERT_LE(thread_ids.size(), 4u);
+}
+
+// 66. 병렬 정렬 기준보다 많은 정렬되지 않은 중복 키로 구성한 트리가 std::set과 같은지 확인
+TEST(BulkBuildTest, ParallelAssignLargeUnsortedRange) {
+  std::vector<int> keys;
+  for (long long i = 0; i < 200000; i++)
+    keys.push_back(static_cast<int>(i * 7919 % 50021));
+  std::set<int> expected(keys.begin(), keys.end());
+
+  AvlTree<int> avl_set;
+  avl_set.Assign(keys.begin(), keys.end(), true);
+  ASSERT_EQ(static_cast<int>(expected.size()), avl_set.Size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), avl_set.begin(),
+                         avl_set.end()));
+  int rank = 0;
+  for (int key : expected) {
+    ASSERT_EQ(++rank, avl_set.Rank(key).second);
+  }
+  // 노드가 50021개인 완전 균형 트리의 높이
+  ASSERT_EQ(16, avl_set.Height());
+}
+
+// 67. 테스트 케이스 여러 개를 병렬로 수행해 이어 쓴 출력이 FastUserTest로 차례로 수행한 출력과 같은지 확인
+TEST(DriverTest, ParallelOutputMatchesSequential) {
+  const char *names[] = {"Insert", "Empty", "Find",     "Size",    "Rank",
+                         "Erase",  "Height", "Ancestor", "Average", "Delete"};
+  std::string input = "9\n";
+  unsigned seed = 12345;
+  for (int test_case = 0; test_case < 9; test_case++) {
+    // 케이스마다 명령어 수와 키 범위를 다르게 해 작업량이 고르지 않게 함
+    int Q = test_case * 150 + 1;
+    input += std::to_string(Q) + "\n";
+    for (int i = 0; i < Q; i++) {
+      seed = seed * 1103515245u + 12345u;
+      const char *name = names[(seed >> 16) % 10];
+      input += name;
+      if (HasOperand(ParseCommand(name)))
+        input += " " + std::to_string((seed >> 8) % (test_case * 20 + 5) - 2);
+      input += "\n";
+    }
+  }
+
+  std::string path = testing::TempDir() + "driver_test_input.txt";
+  FILE *file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  ASSERT_EQ(input.size(), std::fwrite(input.data(), 1, input.size(), file));
+  std::fclose(file);
+
+  OutputBuffer sequential;
+  {
+    InputBuffer in(path.c_str());
+    ASSERT_TRUE(in.IsOpen());
+    int T = 0;
+    in.ReadInt(T);
+    for (int test_case = 1; test_case <= T; test_case++)
+      FastUserTest(in, sequential);
+  }
+
+  OutputBuffer parallel;
+  {
+    InputBuffer in(path.c_str());
+    ASSERT_TRUE(in.IsOpen());
+    int T = 0;
+    in.ReadInt(T);
+    std::vector<::TestCase> test_cases(T);
+    for (::TestCase &test_case : test_cases)
+      ReadTestCase(in, test_case);
+    RunTestCases(test_cases, parallel, 4);
+    for (const ::TestCase &test_case : test_cases)
+      ASSERT_TRUE(test_case.commands.empty());
+  }
+  std::remove(path.c_str());
+
+  ASSERT_FALSE(sequential.View().empty());
+  ASSERT_EQ(sequential.View(), parallel.View());
+}
+
+// 68. 쓰기 스레드가 키를 오름차순으로 삽입/삭제하는 동안 Rank로 본 키 개수와 그 뒤의 Find 결과가 어긋나지 않는지 확인
+TEST(ConcurrentAvlTreeTest, RankIsLinearizableWithFind) {
+  constexpr int kKeys = 20000;
+  ConcurrentAvlTree<int> tree;
+  tree.Insert(kKeys + 1); // 랭크 기준 키
+
+  std::atomic<bool> done(false);
+  std::atomic<int> violations(0);
+  std::atomic<bool> erasing(false);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; t++) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        bool erase_phase = erasing.load();
+        int count = tree.Rank(kKeys + 1).second - 1; // kKeys + 1보다 작은 키의 개수
+        if (!erase_phase) {
+          // 1..count가 모두 삽입된 뒤에 관찰한 개수이므로 count는 이미 보여야 함
+          // (Find 뒤에도 삭제가 시작되지 않았을 때만 판단)
+          if (count > 0 && !tree.Find(count).first && !erasing.load())
+            violations++;
+        } else {
+          // 1..kKeys - count가 모두 삭제된 뒤에 관찰한 개수이므로 그 키는 보이지 않아야 함
+          if (count < kKeys && tree.Find(kKeys - count).first)
+            violations++;
+        }
+      }
+    });
+  }
+  for (int key = 1; key <= kKeys; key++)
+    tree.Insert(key);
+  erasing = true;
+  for (int key = 1; key <= kKeys; key++)
+    tree.Erase(key);
+  done = true;
+  for (std::thread &reader : readers)
+    reader.join();
+  ASSERT_EQ(0, violations.load());
+  ASSERT_EQ(1, tree.Size());
+}
+
+// 69. ParallelFor의 작업에서 던진 예외가 모든 스레드가 끝난 뒤 호출한 스레드로 전달되고 풀을 다시 쓸 수 있는지 확인
+TEST(ParallelForTest, PropagatesExceptionAfterJoin) {
+  for (int call = 0; call < 20; call++) {
+    std::atomic<int> running{0};
+    ASSERT_THROW(ParallelFor(
+                     10000,
+                     [&](size_t begin, size_t) {
+                       running++;
+                       if (begin == static_cast<size_t>(call) * 64)
+                         throw std::runtime_error("chunk failed");
+                       std::this_thread::yield();
+                       running--;
+                     },
+                     4, 64),
+                 std::runtime_error);
+    // 예외를 던진 조각을 빼면 반환 시점에 실행 중인 조각이 없어야 함
+    ASSERT_EQ(1, running.load());
+  }
+  std::atomic<size_t> total{0};
+  ParallelFor(
+      10000, [&](size_t begin, size_t end) { total += end - begin; }, 4, 64);
+  ASSERT_EQ(10000u, total.load());
+}
+
+// 70. B-tree 집합을 Set 인터페이스로 감싸 호출한 결과가 직접 호출한 결과와 같고 순위는 AvlTree와 같은지 확인
+TEST(SetAdapterTest, WrapsBTreeSet) {
+  BTreeSet<int> btree;
+  AvlTree<int> avltree;
+  SetAdapter<BTreeSet<int>> adapter;
+  Set<int> &set = adapter;
+  unsigned int seed = 19;
+  for (int i = 0; i < 5000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 16) % 3000;
+    if (i % 3 == 2) {
+      ASSERT_EQ(btree.Erase(key), set.Erase(key));
+      avltree.Erase(key);
+    } else {
+      ASSERT_EQ(btree.Insert(key), set.Insert(key));
+      avltree.Insert(key);
+    }
+  }
+
+  ASSERT_EQ(avltree.Size(), set.Size());
+  ASSERT_EQ(btree.Height(), set.Height());
+  ASSERT_FALSE(set.Empty());
+  for (int key = -1; key <= 3000; key++) {
+    ASSERT_EQ(btree.Find(key).first != nullptr, set.Find(key).first);
+    ASSERT_EQ(btree.Find(key).second, set.Find(key).second);
+    ASSERT_EQ(btree.Rank(key), set.Rank(key));
+    ASSERT_EQ(avltree.Rank(key).second, set.Rank(key).second);
+    ASSERT_EQ(btree.Ancestor(key), set.Ancestor(key));
+    ASSERT_EQ(btree.Average(key), set.Average(key));
+  }
+}
+
+// 71. B-tree 집합에서 루트 노드의 키는 조상 키의 합이 0이고, 평균은 전체 최솟값과 최댓값의 평균인지 확인
+TEST(SetAdapterTest, BTreeSetAncestorAndAverage) {
+  SetAdapter<BTreeSet<int>> adapter;
+  Set<int> &set = adapter;
+  for (int key : {10, 20, 30})
+    set.Insert(key);
+  ASSERT_EQ(std::make_pair(1, 0), set.Ancestor(20));
+  ASSERT_EQ(20, set.Average(10));
+  ASSERT_EQ(std::make_pair(0, 0), set.Ancestor(25));
+  ASSERT_EQ(0, set.Average(25));
+
+  // 루트가 나뉘면 아래 노드의 키는 루트의 키를 조상으로 가짐
+  for (int key = 1; key <= 100; key++)
+    set.Insert(key * 100);
+  ASSERT_EQ(2, set.Height());
+  std::pair<int, int> ancestor = set.Ancestor(10);
+  ASSERT_EQ(2, ancestor.first);
+  ASSERT_GT(ancestor.second, 0);
+  // 루트 노드의 키는 조상이 없고, 그 부분 트리는 전체 트리
+  int root_keys = 0;
+  for (int key = 100; key <= 10000; key += 100) {
+    if (set.Ancestor(key).second == 0) {
+      root_keys++;
+      ASSERT_EQ((10 + 10000) / 2, set.Average(key));
+    }
+  }
+  ASSERT_GT(root_keys, 0);
+}
+
+// 72. 삽입, 삭제, 일괄 연산, 범위 삭제가 섞여도 end() 힌트가 쓰는 최댓값 노드가 실제 최댓값인지 확인
+TEST(FingerSearchTest, MaxNodeCacheFollowsUpdates) {
+  AvlTree<int> avl_set;
+  std::set<int> expected;
+  auto check = [&] {
+    if (expected.empty())
+      ASSERT_EQ(nullptr, avl_set.GetMaxNode());
+    else
+      ASSERT_EQ(*expected.rbegin(), avl_set.GetMaxNode()->GetKey());
+  };
+
+  unsigned int seed = 7;
+  for (int i = 0; i < 4000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 16) % 1000;
+    if (i % 4 == 3) {
+      // 최댓값 노드를 자주 삭제
+      int erase_key = expected.empty() || i % 8 == 3 ? key : *expected.rbegin();
+      avl_set.Erase(erase_key);
+      expected.erase(erase_key);
+    } else {
+      avl_set.Insert(avl_set.end(), key);
+      expected.insert(key);
+    }
+    check();
+  }
+
+  std::vector<int> batch = {1000, 1001, 1002};
+  avl_set.InsertBatch(batch.begin(), batch.end());
+  expected.insert(batch.begin(), batch.end());
+  check();
+  avl_set.EraseBatch(batch.begin(), batch.end());
+  for (int key : batch)
+    expected.erase(key);
+  check();
+  avl_set.EraseRange(500, 1000);
+  expected.erase(expected.lower_bound(500), expected.end());
+  check();
+  ASSERT_EQ(static_cast<int>(expected.size()), avl_set.Size());
+  while (!expected.empty()) {
+    avl_set.Erase(*expected.rbegin());
+    expected.erase(std::prev(expected.end()));
+    check();
+  }
+}
+
+// 73. 집계값에 소멸자가 있으면 블록 단위 해제 할당자도 Delete에서 노드마다 소멸자를 호출하는지 확인
+struct CountedValue {
+  static inline int live = 0;
+  CountedValue() { live++; }
+  CountedValue(const CountedValue &) { live++; }
+  CountedValue &operator=(const CountedValue &) = default;
+  ~CountedValue() { live--; }
+};
+
+struct CountedAugment {
+  using Value = CountedValue;
+  static Value FromKey(int) { return {}; }
+  static Value Combine(const Value &, const Value &) { return {}; }
+};
+
+TEST(SlabAllocatorTest, DeleteDestroysAggregates) {
+  static_assert(std::is_trivially_destructible<Node<int>>::value,
+                "int 키 노드는 블록 단위로 해제할 수 있어야 합니다");
+  static_assert(!std::is_trivially_destructible<Node<int, CountedAugment>>::value,
+                "집계값의 소멸자가 노드의 소멸자에 포함되어야 합니다");
+  {
+    AvlTree<int, SlabAllocator, CountedAugment> avl_set;
+    for (int key = 0; key < 1000; key++)
+      avl_set.Insert(key);
+    ASSERT_EQ(1000, CountedValue::live);
+    avl_set.Delete();
+    ASSERT_EQ(0, CountedValue::live);
+    avl_set.Insert(1);
+  }
+  ASSERT_EQ(0, CountedValue::live);
+}
+
 // main 함수는 Google Test가 제공하는 기본 메인 함수를 사용
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);